@@ -0,0 +1,130 @@
+/*******************************************************************************
+ * Primitive benchmark of runtime composed vs compile-time bound display / bus.
+ *
+ * Build once with STATIC_DISPATCH 0 and once with STATIC_DISPATCH 1 and compare
+ * the CPU cycles per primitive printed on Serial. The bus time is identical in
+ * both builds, the difference is the dispatch and command overhead.
+ ******************************************************************************/
+#include <Arduino_GFX_Library.h>
+
+#define STATIC_DISPATCH 1
+
+#define GFX_DC 11
+#define GFX_CS 10
+#define GFX_SCK 12
+#define GFX_MOSI 13
+#define GFX_RST 1
+#define GFX_BL 14
+
+#if STATIC_DISPATCH
+Arduino_ESP32SPIDMA *bus = new Arduino_ESP32SPIDMA(GFX_DC, GFX_CS, GFX_SCK, GFX_MOSI, GFX_NOT_DEFINED /* MISO */);
+Arduino_GFX *gfx = new Arduino_TFT_Static<Arduino_ST7789, Arduino_ESP32SPIDMA>(
+    bus, GFX_RST, 1 /* rotation */, true /* IPS */, 170 /* width */, 320 /* height */,
+    35 /* col offset 1 */, 0 /* row offset 1 */, 35 /* col offset 2 */, 0 /* row offset 2 */);
+#else
+Arduino_DataBus *bus = new Arduino_ESP32SPIDMA(GFX_DC, GFX_CS, GFX_SCK, GFX_MOSI, GFX_NOT_DEFINED /* MISO */);
+Arduino_GFX *gfx = new Arduino_ST7789(
+    bus, GFX_RST, 1 /* rotation */, true /* IPS */, 170 /* width */, 320 /* height */,
+    35 /* col offset 1 */, 0 /* row offset 1 */, 35 /* col offset 2 */, 0 /* row offset 2 */);
+#endif
+
+#define TILE_SIZE 16
+uint16_t tile[TILE_SIZE * TILE_SIZE];
+
+void printCycles(const char *item, uint32_t cycles, uint32_t count)
+{
+  Serial.printf("%s\t%lu cycles/op\n", item, (unsigned long)(cycles / count));
+}
+
+uint32_t testPixels()
+{
+  uint32_t start = ESP.getCycleCount();
+  gfx->startWrite();
+  for (int16_t y = 0; y < 64; y++)
+  {
+    for (int16_t x = 0; x < 64; x++)
+    {
+      gfx->writePixel(x, y, x ^ y);
+    }
+  }
+  gfx->endWrite();
+  return ESP.getCycleCount() - start;
+}
+
+uint32_t testScatteredPixels()
+{
+  uint32_t start = ESP.getCycleCount();
+  gfx->startWrite();
+  for (int16_t i = 0; i < 4096; i++)
+  {
+    gfx->writePixel((i * 7) % 320, (i * 13) % 170, i);
+  }
+  gfx->endWrite();
+  return ESP.getCycleCount() - start;
+}
+
+uint32_t testSmallRects()
+{
+  uint32_t start = ESP.getCycleCount();
+  gfx->startWrite();
+  for (int16_t i = 0; i < 1024; i++)
+  {
+    gfx->writeFillRect((i * 8) % 312, (i * 3) % 162, 8, 8, i);
+  }
+  gfx->endWrite();
+  return ESP.getCycleCount() - start;
+}
+
+uint32_t testLines()
+{
+  uint32_t start = ESP.getCycleCount();
+  for (int16_t i = 0; i < 256; i++)
+  {
+    gfx->drawLine(0, 0, 319, (i * 2) % 170, i);
+  }
+  return ESP.getCycleCount() - start;
+}
+
+uint32_t testTiles()
+{
+  uint32_t start = ESP.getCycleCount();
+  for (int16_t i = 0; i < 256; i++)
+  {
+    gfx->draw16bitBeRGBBitmap((i * TILE_SIZE) % 304, (i * 5) % 154, tile, TILE_SIZE, TILE_SIZE);
+  }
+  return ESP.getCycleCount() - start;
+}
+
+void setup(void)
+{
+  Serial.begin(115200);
+  Serial.printf("Arduino_GFX static dispatch benchmark, STATIC_DISPATCH = %d\n", STATIC_DISPATCH);
+
+  if (!gfx->begin())
+  {
+    Serial.println("gfx->begin() failed!");
+  }
+  gfx->fillScreen(RGB565_BLACK);
+
+#ifdef GFX_BL
+  pinMode(GFX_BL, OUTPUT);
+  digitalWrite(GFX_BL, HIGH);
+#endif
+
+  for (uint32_t i = 0; i < TILE_SIZE * TILE_SIZE; i++)
+  {
+    tile[i] = i;
+  }
+}
+
+void loop()
+{
+  printCycles("Pixels (raster)", testPixels(), 64 * 64);
+  printCycles("Pixels (scattered)", testScatteredPixels(), 4096);
+  printCycles("Rectangles 8x8", testSmallRects(), 1024);
+  printCycles("Lines", testLines(), 256);
+  printCycles("Bitmap 16x16", testTiles(), 256);
+  Serial.println("Done!");
+
+  delay(5000);
+}
@@ -183,34 +183,24 @@ void Arduino_DataBus::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_t
 {
   int cols = w >> 1;
 
-  uint8_t pxCb, pxCr;
-  int16_t pxR, pxG, pxB, pxY;
+  uint32_t buf[16]; // 32 pixels, word aligned
+  uint16_t l;
 
-  for (int row = 0; row < h;)
+  for (int row = 0; row < h; ++row)
   {
-    for (int col = 0; col < cols; ++col)
+    for (uint16_t col = 0; col < w; col += l)
     {
-      pxCb = *cbData++;
-      pxCr = *crData++;
-      pxR = CR2R16[pxCr];
-      pxG = -CB2G16[pxCb] - CR2G16[pxCr];
-      pxB = CB2B16[pxCb];
-
-      pxY = Y2I16[*yData++];
-      _data16.value = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-      write(_data16.lsb);
-      write(_data16.msb);
-      pxY = Y2I16[*yData++];
-      _data16.value = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-      write(_data16.lsb);
-      write(_data16.msb);
+      l = ((w - col) > 32) ? 32 : (w - col);
+      gfx_ycbcr_to_rgb565((uint16_t *)buf, yData + col, cbData + (col >> 1), crData + (col >> 1), l, true);
+      writeBytes((uint8_t *)buf, (uint32_t)l << 1);
     }
+    yData += w;
 
-    if (++row & 1)
+    if (row & 1)
     {
-      // rollback CbCr data
-      cbData -= cols;
-      crData -= cols;
+      // next CbCr row every 2 rows
+      cbData += cols;
+      crData += cols;
     }
   }
 }
@@ -7,7 +7,7 @@
 
 #include <Arduino.h>
 
-#include "YCbCr2RGB.h"
+#include "Arduino_PixelKernels.h"
 
 #define GFX_SKIP_OUTPUT_BEGIN -2
 #define GFX_NOT_DEFINED -1
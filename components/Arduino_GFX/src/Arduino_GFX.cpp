@@ -1631,7 +1631,7 @@ void Arduino_GFX::draw16bitBeRGBBitmapR1(int16_t x, int16_t y,
     {
       p = bitmap[offset++];
       MSB_16_SET(p, p);
-      writePixel(x + w - j - 1, y + i, p);
+      writePixel(x + h - j - 1, y + i, p);
     }
   }
   endWrite();
@@ -98,6 +98,8 @@
 #include "display/Arduino_ST7796.h"
 #include "display/Arduino_WEA2012.h"
 
+#include "Arduino_TFT_Static.h"
+
 #if defined(ARDUINO_ARCH_SAMD) && defined(SEEED_GROVE_UI_WIRELESS)
 #define DISPLAY_DEV_KIT
 #define WIO_TERMINAL
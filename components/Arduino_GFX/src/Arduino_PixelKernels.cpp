@@ -0,0 +1,274 @@
+#include "Arduino_PixelKernels.h"
+
+void gfx_swap16(uint16_t *dst, const uint16_t *src, uint32_t len)
+{
+#if GFX_PIE_ENABLED
+  if ((len >= 16) && ((((uintptr_t)dst) | ((uintptr_t)src)) & 0xF) == 0)
+  {
+    uint32_t l = len & ~15UL;
+    gfx_swap16_aes3(dst, src, l);
+    dst += l;
+    src += l;
+    len -= l;
+  }
+#endif
+
+  if ((((uintptr_t)dst) | ((uintptr_t)src)) & 0x3)
+  {
+    while (len--)
+    {
+      *dst++ = GFX_SWAP16(*src);
+      ++src;
+    }
+    return;
+  }
+
+  uint32_t *d32 = (uint32_t *)dst;
+  const uint32_t *s32 = (const uint32_t *)src;
+  uint32_t l2 = len >> 1;
+  uint32_t v;
+  while (l2 >= 4)
+  {
+    v = s32[0];
+    d32[0] = GFX_SWAP16X2(v);
+    v = s32[1];
+    d32[1] = GFX_SWAP16X2(v);
+    v = s32[2];
+    d32[2] = GFX_SWAP16X2(v);
+    v = s32[3];
+    d32[3] = GFX_SWAP16X2(v);
+    s32 += 4;
+    d32 += 4;
+    l2 -= 4;
+  }
+  while (l2--)
+  {
+    v = *s32++;
+    *d32++ = GFX_SWAP16X2(v);
+  }
+  if (len & 1)
+  {
+    *(uint16_t *)d32 = GFX_SWAP16(*(const uint16_t *)s32);
+  }
+}
+
+void gfx_index8_to_be565(uint16_t *dst, const uint8_t *data, const uint16_t *idx, uint32_t len)
+{
+  if (((uintptr_t)dst) & 0x3)
+  {
+    while (len--)
+    {
+      *dst++ = GFX_SWAP16(idx[*data]);
+      ++data;
+    }
+    return;
+  }
+
+  uint32_t *d32 = (uint32_t *)dst;
+  uint32_t l2 = len >> 1;
+  uint32_t v;
+  while (l2--)
+  {
+    v = idx[data[0]] | ((uint32_t)idx[data[1]] << 16);
+    *d32++ = GFX_SWAP16X2(v);
+    data += 2;
+  }
+  if (len & 1)
+  {
+    *(uint16_t *)d32 = GFX_SWAP16(idx[*data]);
+  }
+}
+
+void gfx_index8_to_be565_double(uint16_t *dst, const uint8_t *data, const uint16_t *idx, uint32_t len)
+{
+  uint32_t v;
+  if (((uintptr_t)dst) & 0x3)
+  {
+    while (len--)
+    {
+      v = GFX_SWAP16(idx[*data]);
+      ++data;
+      *dst++ = v;
+      *dst++ = v;
+    }
+    return;
+  }
+
+  uint32_t *d32 = (uint32_t *)dst;
+  while (len--)
+  {
+    v = idx[*data++];
+    v |= v << 16;
+    *d32++ = GFX_SWAP16X2(v);
+  }
+}
+
+/*
+ * 4 pixels are 3 words, little endian:
+ *   w0 = R0 G0 B0 R1, w1 = G1 B1 R2 G2, w2 = B2 R3 G3 B3
+ * so every channel is masked / shifted straight out of the loaded words.
+ * There is no PIE version: splitting the 3 byte stride into R, G, B planes
+ * needs a 3-way de-interleave, PIE only has 2-way zip / unzip permutes.
+ */
+void gfx_rgb888_to_be565(uint16_t *dst, const uint8_t *rgb, uint32_t len)
+{
+  // big endian RGB565: byte 0 = RRRRRGGG, byte 1 = GGGBBBBB
+  uint32_t p0, p1, p2, p3;
+
+  // at most 3 pixels until the source is word aligned
+  while (len && (((uintptr_t)rgb) & 0x3))
+  {
+    p0 = ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+    *dst++ = GFX_SWAP16(p0);
+    rgb += 3;
+    --len;
+  }
+
+  const uint32_t *s32 = (const uint32_t *)rgb;
+  bool aligned = (((uintptr_t)dst) & 0x3) == 0;
+  uint32_t l4 = len >> 2;
+  uint32_t w0, w1, w2, v01, v23;
+  while (l4--)
+  {
+    w0 = s32[0];
+    w1 = s32[1];
+    w2 = s32[2];
+    p0 = ((w0 & 0xF8) << 8) | ((w0 >> 5) & 0x07E0) | ((w0 >> 19) & 0x1F);
+    p1 = ((w0 >> 16) & 0xF800) | ((w1 & 0xFC) << 3) | ((w1 >> 11) & 0x1F);
+    p2 = ((w1 >> 8) & 0xF800) | ((w1 >> 21) & 0x07E0) | ((w2 & 0xF8) >> 3);
+    p3 = (w2 & 0xF800) | ((w2 >> 13) & 0x07E0) | (w2 >> 27);
+    v01 = p0 | (p1 << 16);
+    v23 = p2 | (p3 << 16);
+    v01 = GFX_SWAP16X2(v01);
+    v23 = GFX_SWAP16X2(v23);
+    if (aligned)
+    {
+      ((uint32_t *)dst)[0] = v01;
+      ((uint32_t *)dst)[1] = v23;
+    }
+    else
+    {
+      dst[0] = v01;
+      dst[1] = v01 >> 16;
+      dst[2] = v23;
+      dst[3] = v23 >> 16;
+    }
+    s32 += 3;
+    dst += 4;
+  }
+
+  rgb = (const uint8_t *)s32;
+  len &= 3;
+  while (len--)
+  {
+    p0 = ((rgb[0] & 0xF8) << 8) | ((rgb[1] & 0xFC) << 3) | (rgb[2] >> 3);
+    *dst++ = GFX_SWAP16(p0);
+    rgb += 3;
+  }
+}
+
+/*
+ * Fixed point (8 fractional bits) YCbCr -> RGB, same coefficients as the
+ * former YCbCr2RGB.h lookup tables:
+ *   R = 1.164 (Y - 16) + 1.596 (Cr - 128)
+ *   G = 1.164 (Y - 16) - 0.392 (Cb - 128) - 0.813 (Cr - 128)
+ *   B = 1.164 (Y - 16) + 2.017 (Cb - 128)
+ * Per block of GFX_YCBCR_BLOCK pixels the chroma terms are computed once
+ * per Cb / Cr sample and stored for both pixels sharing it, so the pixel
+ * loop is element wise over equal length arrays: no i >> 1 gather, no
+ * branch, clamps the compiler lowers to min / max. That loop is what a
+ * vectorizing compiler (or a SIMD port of it) needs; Xtensa GCC has no PIE
+ * auto-vectorizer, so on ESP32-S3 only the big endian swap runs on PIE.
+ * test/test_pixel_kernels.cpp checks all 2^24 inputs against the former
+ * tables, every channel is within 1 LSB.
+ */
+#define GFX_YCBCR_BLOCK 16
+
+static inline int32_t gfx_clip8(int32_t v)
+{
+  return (v < 0) ? 0 : ((v > 255) ? 255 : v);
+}
+
+void gfx_ycbcr_to_rgb565(uint16_t *dst, const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t w, bool be)
+{
+  // chroma terms per pixel, 8.8 fixed point with the rounding offset included
+  int32_t cR[GFX_YCBCR_BLOCK], cG[GFX_YCBCR_BLOCK], cB[GFX_YCBCR_BLOCK];
+  int32_t u, v, l, r, g, b;
+  uint16_t *d = dst;
+  uint32_t len = w;
+  uint32_t n, i;
+  while (len)
+  {
+    n = (len > GFX_YCBCR_BLOCK) ? GFX_YCBCR_BLOCK : len;
+    for (i = 0; i < n; i += 2)
+    {
+      u = (int32_t)cb[i >> 1] - 128;
+      v = (int32_t)cr[i >> 1] - 128;
+      cR[i] = cR[i + 1] = 409 * v + 128;
+      cG[i] = cG[i + 1] = -100 * u - 208 * v + 128;
+      cB[i] = cB[i + 1] = 516 * u + 128;
+    }
+    for (i = 0; i < n; ++i)
+    {
+      l = 298 * ((int32_t)y[i] - 16);
+      r = gfx_clip8((l + cR[i]) >> 8);
+      g = gfx_clip8((l + cG[i]) >> 8);
+      b = gfx_clip8((l + cB[i]) >> 8);
+      d[i] = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+    }
+    d += n;
+    y += n;
+    cb += n >> 1;
+    cr += n >> 1;
+    len -= n;
+  }
+
+  if (be)
+  {
+    gfx_swap16(dst, dst, w);
+  }
+}
+
+void gfx_rotate_r1(uint16_t *dst, const uint16_t *bitmap, int16_t w, int16_t h, int16_t c0, int16_t c1, int16_t r, int16_t rows)
+{
+  // output (c, r) = bitmap row (h - 1 - c), column r: each bitmap row gives
+  // rows contiguous pixels to one output column, so reads stay sequential
+  // and the destination band stays in cache
+  int16_t cw = c1 - c0;
+  const uint16_t *src;
+  uint16_t *d;
+  for (int16_t c = c0; c < c1; ++c)
+  {
+    src = bitmap + ((int32_t)(h - 1 - c) * w) + r;
+    d = dst + (c - c0);
+    for (int16_t i = 0; i < rows; ++i)
+    {
+      *d = src[i];
+      d += cw;
+    }
+  }
+}
+
+void gfx_blend565(uint16_t *dst, const uint16_t *fg, const uint16_t *bg, const uint8_t *alpha, uint32_t len)
+{
+  uint8_t a;
+  while (len--)
+  {
+    a = *alpha++;
+    if (a == 255)
+    {
+      *dst = *fg;
+    }
+    else if (a == 0)
+    {
+      *dst = *bg;
+    }
+    else
+    {
+      *dst = gfx_blend565(*fg, *bg, a);
+    }
+    ++dst;
+    ++fg;
+    ++bg;
+  }
+}
@@ -0,0 +1,79 @@
+/*
+ * Bulk pixel conversion kernels used by the data bus write paths.
+ *
+ * All kernels write big endian RGB565 (the byte order the panels expect on
+ * the wire) unless stated otherwise. The portable versions work on two pixels
+ * per 32-bit word; on ESP32-S3 gfx_swap16() additionally uses the PIE 128-bit
+ * vector unit (16 pixels per loop) when both buffers are 16-byte
+ * aligned, e.g. the DMA buffers allocated by Arduino_ESP32SPIDMA.
+ */
+#ifndef _ARDUINO_PIXELKERNELS_H_
+#define _ARDUINO_PIXELKERNELS_H_
+
+#include <Arduino.h>
+
+#if defined(ESP32) && (CONFIG_IDF_TARGET_ESP32S3)
+#define GFX_PIE_ENABLED 1
+#else
+#define GFX_PIE_ENABLED 0
+#endif
+
+// byte swap 1 RGB565 pixel / 2 RGB565 pixels packed in a 32-bit word (v is evaluated twice)
+#define GFX_SWAP16(v) ((uint16_t)((((v) & 0xFF00) >> 8) | (((v) & 0xFF) << 8)))
+#define GFX_SWAP16X2(v) ((((v) & 0x00FF00FFUL) << 8) | (((v) >> 8) & 0x00FF00FFUL))
+
+/**
+ * @brief dst[i] = byte swapped src[i], dst may be equal to src
+ */
+void gfx_swap16(uint16_t *dst, const uint16_t *src, uint32_t len);
+
+/**
+ * @brief dst[i] = byte swapped idx[data[i]]
+ */
+void gfx_index8_to_be565(uint16_t *dst, const uint8_t *data, const uint16_t *idx, uint32_t len);
+
+/**
+ * @brief dst[i] = byte swapped idx[data[i]], each pixel written twice
+ */
+void gfx_index8_to_be565_double(uint16_t *dst, const uint8_t *data, const uint16_t *idx, uint32_t len);
+
+/**
+ * @brief pack len R, G, B byte triplets into big endian RGB565
+ */
+void gfx_rgb888_to_be565(uint16_t *dst, const uint8_t *rgb, uint32_t len);
+
+/**
+ * @brief convert 1 row of YCbCr (BT.601, Cb and Cr horizontally
+ * subsampled by 2) to RGB565, big endian if be is true
+ */
+void gfx_ycbcr_to_rgb565(uint16_t *dst, const uint8_t *y, const uint8_t *cb, const uint8_t *cr, uint32_t w, bool be);
+
+/**
+ * @brief rotate a w x h bitmap 90 degrees clockwise, write rows [r, r + rows)
+ * and columns [c0, c1) of the h x w result to dst, c1 - c0 pixels per row
+ */
+void gfx_rotate_r1(uint16_t *dst, const uint16_t *bitmap, int16_t w, int16_t h, int16_t c0, int16_t c1, int16_t r, int16_t rows);
+
+/**
+ * @brief blend one native endian RGB565 pixel, alpha 0 (bg) - 255 (fg)
+ */
+inline uint16_t gfx_blend565(uint16_t fg, uint16_t bg, uint8_t alpha)
+{
+  // spread R, G, B with gaps so the three channels multiply in one 32-bit word
+  uint32_t a = ((uint32_t)alpha + 4) >> 3;
+  uint32_t f = (fg | ((uint32_t)fg << 16)) & 0x07E0F81FUL;
+  uint32_t b = (bg | ((uint32_t)bg << 16)) & 0x07E0F81FUL;
+  uint32_t r = ((((f - b) * a) >> 5) + b) & 0x07E0F81FUL;
+  return (uint16_t)(r | (r >> 16));
+}
+
+/**
+ * @brief dst[i] = blend of fg[i] over bg[i] with alpha[i], native endian RGB565
+ */
+void gfx_blend565(uint16_t *dst, const uint16_t *fg, const uint16_t *bg, const uint8_t *alpha, uint32_t len);
+
+#if GFX_PIE_ENABLED
+extern "C" void gfx_swap16_aes3(uint16_t *dst, const uint16_t *src, uint32_t len);
+#endif
+
+#endif // _ARDUINO_PIXELKERNELS_H_
@@ -18,6 +18,14 @@ Arduino_TFT::Arduino_TFT(
   _rotation = r;
 }
 
+Arduino_TFT::~Arduino_TFT()
+{
+  if (_r1Buf)
+  {
+    free(_r1Buf);
+  }
+}
+
 bool Arduino_TFT::begin(int32_t speed)
 {
   if (_override_datamode != GFX_NOT_DEFINED)
@@ -44,17 +52,26 @@ bool Arduino_TFT::begin(int32_t speed)
 
 void Arduino_TFT::startWrite()
 {
+  _streamX = GFX_NOT_DEFINED;
   _bus->beginWrite();
 }
 
+// Consecutive pixels in raster order are streamed under one address window.
+// A new window is only opened on discontinuity, it spans from the pixel to
+// the right edge so the following pixels of the same row need no command.
 void Arduino_TFT::writePixelPreclipped(int16_t x, int16_t y, uint16_t color)
 {
-  writeAddrWindow(x, y, 1, 1);
+  if (streamBreak(x, y))
+  {
+    writeAddrWindow(x, y, _width - x, 1);
+  }
   _bus->write16(color);
+  streamAdvance(x, y);
 }
 
 void Arduino_TFT::writeRepeat(uint16_t color, uint32_t len)
 {
+  _streamX = GFX_NOT_DEFINED;
   _bus->writeRepeat(color, len);
 }
 
@@ -125,12 +142,14 @@ void Arduino_TFT::writeFillRectPreclipped(
 #ifdef ESP8266
   yield();
 #endif
+  _streamX = GFX_NOT_DEFINED;
   writeAddrWindow(x, y, w, h);
   writeRepeat(color, (uint32_t)w * h);
 }
 
 void Arduino_TFT::endWrite()
 {
+  _streamX = GFX_NOT_DEFINED;
   _bus->endWrite();
 }
 
@@ -174,10 +193,12 @@ void Arduino_TFT::setRotation(uint8_t r)
   _currentY = 0xFFFF;
   _currentW = 0xFFFF;
   _currentH = 0xFFFF;
+  _streamX = GFX_NOT_DEFINED;
 }
 
 void Arduino_TFT::writeColor(uint16_t color)
 {
+  _streamX = GFX_NOT_DEFINED;
   _bus->write16(color);
 }
 
@@ -186,11 +207,13 @@ void Arduino_TFT::writeColor(uint16_t color)
 
 void Arduino_TFT::writeBytes(uint8_t *data, uint32_t len)
 {
+  _streamX = GFX_NOT_DEFINED;
   _bus->writeBytes(data, len);
 }
 
 void Arduino_TFT::writePixels(uint16_t *data, uint32_t len)
 {
+  _streamX = GFX_NOT_DEFINED;
   _bus->writePixels(data, len);
 }
 
@@ -257,11 +280,13 @@ void Arduino_TFT::writeSlashLine(int16_t x0, int16_t y0, int16_t x1, int16_t y1,
 
 void Arduino_TFT::writeIndexedPixels(uint8_t *bitmap, uint16_t *color_index, uint32_t len)
 {
+  _streamX = GFX_NOT_DEFINED;
   _bus->writeIndexedPixels(bitmap, color_index, len);
 }
 
 void Arduino_TFT::writeIndexedPixelsDouble(uint8_t *bitmap, uint16_t *color_index, uint32_t len)
 {
+  _streamX = GFX_NOT_DEFINED;
   _bus->writeIndexedPixelsDouble(bitmap, color_index, len);
 }
 
@@ -719,21 +744,54 @@ void Arduino_TFT::draw16bitBeRGBBitmapR1(
     return;
   }
   else if (
-      (x < 0) ||                // Clip left
-      (y < 0) ||                // Clip top
-      ((x + h - 1) > _max_x) || // Clip right
-      ((y + w - 1) > _max_y)    // Clip bottom
+      (x >= 0) &&                // Not clip left
+      (y >= 0) &&                // Not clip top
+      ((x + h - 1) <= _max_x) && // Not clip right
+      ((y + w - 1) <= _max_y)    // Not clip bottom
   )
   {
-    Arduino_GFX::draw16bitBeRGBBitmapR1(x, y, bitmap, w, h);
-  }
-  else
-  {
+    // the bus may have its own rotated write, e.g. Arduino_ESP32QSPI
     startWrite();
     writeAddrWindow(x, y, h, w);
     _bus->write16bitBeRGBBitmapR1(bitmap, w, h);
     endWrite();
+    return;
   }
+
+  // clipped, transpose the visible part through the band buffer
+  if (!_r1Buf)
+  {
+    size_t s = TFT_R1_BAND_ROWS * ((WIDTH > HEIGHT) ? WIDTH : HEIGHT) * 2;
+#if defined(ESP32)
+    _r1Buf = (uint16_t *)heap_caps_aligned_alloc(16, s, MALLOC_CAP_DMA);
+#else
+    _r1Buf = (uint16_t *)malloc(s);
+#endif
+    if (!_r1Buf)
+    {
+      Arduino_GFX::draw16bitBeRGBBitmapR1(x, y, bitmap, w, h);
+      return;
+    }
+  }
+
+  // output is h columns x w rows: output (c, r) = bitmap row (h - 1 - c), column r
+  int16_t c0 = (x < 0) ? -x : 0;
+  int16_t c1 = ((x + h - 1) > _max_x) ? (_max_x - x + 1) : h;
+  int16_t r0 = (y < 0) ? -y : 0;
+  int16_t r1 = ((y + w - 1) > _max_y) ? (_max_y - y + 1) : w;
+  int16_t cw = c1 - c0;
+  int16_t bh;
+
+  startWrite();
+  _streamX = GFX_NOT_DEFINED;
+  writeAddrWindow(x + c0, y + r0, cw, r1 - r0);
+  for (int16_t r = r0; r < r1; r += bh)
+  {
+    bh = ((r1 - r) > TFT_R1_BAND_ROWS) ? TFT_R1_BAND_ROWS : (r1 - r);
+    gfx_rotate_r1(_r1Buf, bitmap, w, h, c0, c1, r, bh);
+    _bus->writeBytes((uint8_t *)_r1Buf, (uint32_t)bh * cw * 2);
+  }
+  endWrite();
 }
 
 void Arduino_TFT::draw24bitRGBBitmap(
@@ -798,13 +856,17 @@ void Arduino_TFT::draw24bitRGBBitmap(
   else
   {
     uint32_t len = (uint32_t)w * h;
-    uint32_t offset = 0;
+    uint32_t l;
+    uint32_t buf[TFT_24BIT_CHUNK_PIXELS / 2]; // word aligned for the bus DMA
     startWrite();
     writeAddrWindow(x, y, w, h);
-    while (len--)
+    while (len)
     {
-      _bus->write16(color565(bitmap[offset], bitmap[offset + 1], bitmap[offset + 2]));
-      offset += 3;
+      l = (len > TFT_24BIT_CHUNK_PIXELS) ? TFT_24BIT_CHUNK_PIXELS : len;
+      gfx_rgb888_to_be565((uint16_t *)buf, bitmap, l);
+      _bus->writeBytes((uint8_t *)buf, l << 1);
+      bitmap += l * 3;
+      len -= l;
     }
     endWrite();
   }
@@ -8,10 +8,19 @@
 #include "Arduino_DataBus.h"
 #include "Arduino_GFX.h"
 
+#ifndef TFT_24BIT_CHUNK_PIXELS
+#define TFT_24BIT_CHUNK_PIXELS 128 // draw24bitRGBBitmap stack line buffer
+#endif
+
+#ifndef TFT_R1_BAND_ROWS
+#define TFT_R1_BAND_ROWS 8 // output rows per draw16bitBeRGBBitmapR1 line buffer
+#endif
+
 class Arduino_TFT : public Arduino_GFX
 {
 public:
   Arduino_TFT(Arduino_DataBus *bus, int8_t rst, uint8_t r, bool ips, int16_t w, int16_t h, uint8_t col_offset1, uint8_t row_offset1, uint8_t col_offset2, uint8_t row_offset2);
+  ~Arduino_TFT();
 
   // This SHOULD be defined by the subclass:
   void setRotation(uint8_t r) override;
@@ -71,6 +80,17 @@ protected:
   uint8_t _xStart, _yStart;
   int16_t _currentX, _currentY;
   uint16_t _currentW, _currentH;
+  // next raster position of the open pixel stream, GFX_NOT_DEFINED if none
+  int16_t _streamX = GFX_NOT_DEFINED, _streamY = GFX_NOT_DEFINED;
+  // pixel stream bookkeeping of writePixelPreclipped(), shared with Arduino_TFT_Static
+  inline bool streamBreak(int16_t x, int16_t y) const { return (x != _streamX) || (y != _streamY); }
+  inline void streamAdvance(int16_t x, int16_t y)
+  {
+    _streamX = (x < _max_x) ? (x + 1) : GFX_NOT_DEFINED;
+    _streamY = y;
+  }
+  // draw16bitBeRGBBitmapR1 transpose buffer, TFT_R1_BAND_ROWS x max(WIDTH, HEIGHT)
+  uint16_t *_r1Buf = nullptr;
   int8_t _override_datamode = GFX_NOT_DEFINED;
 
 private:
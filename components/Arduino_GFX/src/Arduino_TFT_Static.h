@@ -0,0 +1,144 @@
+/*
+ * Compile-time bound display / data bus pair.
+ *
+ * Arduino_TFT_Static<Arduino_ST7789, Arduino_ESP32SPIDMA> behaves exactly like
+ * Arduino_ST7789 constructed on an Arduino_ESP32SPIDMA, but the hot path
+ * (address window, pixel, repeat and byte writes) calls the bus with qualified
+ * names, which saves the Arduino_DataBus vtable lookup per call. The bus
+ * methods themselves stay out of line in their .cpp. The object is still an
+ * Arduino_GFX and can be used through Arduino_GFX * side by side with runtime
+ * composed ones.
+ *
+ * DISPLAY_T must use MIPI DCS style addressing and provide its commands as
+ * CMD_CASET / CMD_RASET / CMD_RAMWR, see Arduino_ST7789.
+ */
+#ifndef _ARDUINO_TFT_STATIC_H_
+#define _ARDUINO_TFT_STATIC_H_
+
+#include "Arduino_DataBus.h"
+#include "Arduino_TFT.h"
+
+template <class DISPLAY_T, class BUS_T>
+class Arduino_TFT_Static : public DISPLAY_T
+{
+public:
+  template <typename... Args>
+  Arduino_TFT_Static(BUS_T *bus, Args... args)
+      : DISPLAY_T(bus, args...), _sbus(bus)
+  {
+  }
+
+  void writeAddrWindow(int16_t x, int16_t y, uint16_t w, uint16_t h) override final
+  {
+    if ((x != this->_currentX) || (w != this->_currentW))
+    {
+      this->_currentX = x;
+      this->_currentW = w;
+      x += this->_xStart;
+      _sbus->BUS_T::writeC8D16D16(DISPLAY_T::CMD_CASET, x, x + w - 1);
+    }
+
+    if ((y != this->_currentY) || (h != this->_currentH))
+    {
+      this->_currentY = y;
+      this->_currentH = h;
+      y += this->_yStart;
+      _sbus->BUS_T::writeC8D16D16(DISPLAY_T::CMD_RASET, y, y + h - 1);
+    }
+
+    _sbus->BUS_T::writeCommand(DISPLAY_T::CMD_RAMWR);
+  }
+
+  void writePixelPreclipped(int16_t x, int16_t y, uint16_t color) override final
+  {
+    if (this->streamBreak(x, y))
+    {
+      writeAddrWindow(x, y, this->_width - x, 1);
+    }
+    _sbus->BUS_T::write16(color);
+    this->streamAdvance(x, y);
+  }
+
+  void writeFillRectPreclipped(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) override final
+  {
+    this->_streamX = GFX_NOT_DEFINED;
+    writeAddrWindow(x, y, w, h);
+    _sbus->BUS_T::writeRepeat(color, (uint32_t)w * h);
+  }
+
+  void writeRepeat(uint16_t color, uint32_t len) override final
+  {
+    this->_streamX = GFX_NOT_DEFINED;
+    _sbus->BUS_T::writeRepeat(color, len);
+  }
+
+  void writeColor(uint16_t color) override final
+  {
+    this->_streamX = GFX_NOT_DEFINED;
+    _sbus->BUS_T::write16(color);
+  }
+
+#if !defined(LITTLE_FOOT_PRINT)
+  void writePixels(uint16_t *data, uint32_t len) override final
+  {
+    this->_streamX = GFX_NOT_DEFINED;
+    _sbus->BUS_T::writePixels(data, len);
+  }
+
+  void draw16bitBeRGBBitmap(int16_t x, int16_t y, uint16_t *bitmap, int16_t w, int16_t h) override
+  {
+    if (
+        ((x + w - 1) < 0) ||   // Outside left
+        ((y + h - 1) < 0) ||   // Outside top
+        (x > this->_max_x) ||  // Outside right
+        (y > this->_max_y)     // Outside bottom
+    )
+    {
+      return;
+    }
+
+    int16_t out_width = w;
+    if ((y + h - 1) > this->_max_y)
+    {
+      h -= (y + h - 1) - this->_max_y;
+    }
+    if (y < 0)
+    {
+      bitmap -= y * w;
+      h += y;
+      y = 0;
+    }
+    if ((x + w - 1) > this->_max_x)
+    {
+      out_width -= (x + w - 1) - this->_max_x;
+    }
+    if (x < 0)
+    {
+      bitmap -= x;
+      out_width += x;
+      x = 0;
+    }
+
+    this->startWrite();
+    writeAddrWindow(x, y, out_width, h);
+    if (out_width < w)
+    {
+      for (int16_t j = 0; j < h; j++)
+      {
+        _sbus->BUS_T::writeBytes((uint8_t *)bitmap, (uint32_t)out_width << 1);
+        bitmap += w;
+      }
+    }
+    else
+    {
+      _sbus->BUS_T::writeBytes((uint8_t *)bitmap, (uint32_t)w * h * 2);
+    }
+    this->endWrite();
+  }
+#endif // !defined(LITTLE_FOOT_PRINT)
+
+protected:
+  BUS_T *_sbus;
+};
+
+#endif // _ARDUINO_TFT_STATIC_H_
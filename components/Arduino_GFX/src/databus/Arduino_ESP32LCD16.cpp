@@ -483,33 +483,17 @@ void Arduino_ESP32LCD16::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8
     uint16_t *dest = _buffer16;
     uint16_t *dest2 = dest + w;
 
-    uint8_t pxCb, pxCr;
-    int16_t pxR, pxG, pxB, pxY;
-  
     uint16_t l = (w * 4) - 4;
     uint32_t out_dmadesc = ((l + 3) & (~3)) | l << 12 | 0xC0000000;
     bool poll_started = false;
     for (int row = 0; row < rows; ++row)
     {
-      for (int col = 0; col < cols; ++col)
-      {
-        pxCb = *cbData++;
-        pxCr = *crData++;
-        pxR = CR2R16[pxCr];
-        pxG = -CB2G16[pxCb] - CR2G16[pxCr];
-        pxB = CB2B16[pxCb];
-
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-      }
-      yData += w;
-      yData2 += w;
+      gfx_ycbcr_to_rgb565(dest, yData, cbData, crData, w, false);
+      gfx_ycbcr_to_rgb565(dest2, yData2, cbData, crData, w, false);
+      cbData += cols;
+      crData += cols;
+      yData += w << 1;
+      yData2 += w << 1;
 
       if (poll_started)
       {
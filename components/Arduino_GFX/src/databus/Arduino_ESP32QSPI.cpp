@@ -720,31 +720,15 @@ void Arduino_ESP32QSPI::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint8_
 
     uint16_t out_bits = w << 5;
 
-    uint8_t pxCb, pxCr;
-    int16_t pxR, pxG, pxB, pxY;
-
     CS_LOW();
     for (int row = 0; row < rows; ++row)
     {
-      for (int col = 0; col < cols; ++col)
-      {
-        pxCb = *cbData++;
-        pxCr = *crData++;
-        pxR = CR2R16[pxCr];
-        pxG = -CB2G16[pxCb] - CR2G16[pxCr];
-        pxB = CB2B16[pxCb];
-
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-      }
-      yData += w;
-      yData2 += w;
+      gfx_ycbcr_to_rgb565(dest, yData, cbData, crData, w, true);
+      gfx_ycbcr_to_rgb565(dest2, yData2, cbData, crData, w, true);
+      cbData += cols;
+      crData += cols;
+      yData += w << 1;
+      yData2 += w << 1;
 
       if (first_send)
       {
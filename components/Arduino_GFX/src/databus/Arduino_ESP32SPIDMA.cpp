@@ -601,23 +601,12 @@ void Arduino_ESP32SPIDMA::writePixels(uint16_t *data, uint32_t len)
       flush_data_buf();
     }
 
-    uint32_t l, l2;
-    uint16_t p1, p2;
+    uint32_t l;
     while (len)
     {
       l = (len > ESP32SPIDMA_MAX_PIXELS_AT_ONCE) ? ESP32SPIDMA_MAX_PIXELS_AT_ONCE : len;
-      l2 = (l + 1) >> 1;
-      for (uint32_t i = 0; i < l2; ++i)
-      {
-        p1 = *data++;
-        p2 = *data++;
-        MSB_32_16_16_SET(_buffer32[i], p1, p2);
-      }
-      if (l & 1)
-      {
-        p1 = *data++;
-        MSB_16_SET(_buffer16[l - 1], p1);
-      }
+      gfx_swap16(_buffer16, data, l);
+      data += l;
 
       _spi_tran.tx_buffer = _buffer32;
       _spi_tran.length = l << 4;
@@ -704,6 +693,60 @@ void Arduino_ESP32SPIDMA::writeBytes(uint8_t *data, uint32_t len)
   }
 }
 
+/**
+ * @brief write16bitBeRGBBitmapR1
+ *
+ * @param bitmap
+ * @param w
+ * @param h
+ */
+void Arduino_ESP32SPIDMA::write16bitBeRGBBitmapR1(uint16_t *bitmap, int16_t w, int16_t h)
+{
+  if ((_dc == GFX_NOT_DEFINED) || (h > ESP32SPIDMA_MAX_PIXELS_AT_ONCE)) // 9-bit SPI or output row too long
+  {
+    Arduino_DataBus::write16bitBeRGBBitmapR1(bitmap, w, h);
+  }
+  else // 8-bit SPI
+  {
+    if (_data_buf_bit_idx > 0)
+    {
+      flush_data_buf();
+    }
+
+    // as many output rows as fit in one buffer, the next band is rotated
+    // into the other buffer while this one is sent
+    int16_t band = ESP32SPIDMA_MAX_PIXELS_AT_ONCE / h;
+    int16_t bh;
+    uint16_t *dest = _buffer16;
+    bool poll_started = false;
+    for (int16_t r = 0; r < w; r += bh)
+    {
+      bh = ((w - r) > band) ? band : (w - r);
+      gfx_rotate_r1(dest, bitmap, w, h, 0, h, r, bh);
+
+      if (poll_started)
+      {
+        POLL_END();
+      }
+      else
+      {
+        poll_started = true;
+      }
+      _spi_tran.tx_buffer = dest;
+      _spi_tran.length = ((uint32_t)bh * h) << 4;
+      _spi_tran.flags = 0;
+
+      POLL_START();
+      dest = (dest == _buffer16) ? _2nd_buffer16 : _buffer16;
+    }
+
+    if (poll_started)
+    {
+      POLL_END();
+    }
+  }
+}
+
 /**
  * @brief writeIndexedPixels
  *
@@ -727,23 +770,12 @@ void Arduino_ESP32SPIDMA::writeIndexedPixels(uint8_t *data, uint16_t *idx, uint3
       flush_data_buf();
     }
 
-    uint32_t l, l2;
-    uint16_t p1, p2;
+    uint32_t l;
     while (len)
     {
       l = (len > ESP32SPIDMA_MAX_PIXELS_AT_ONCE) ? ESP32SPIDMA_MAX_PIXELS_AT_ONCE : len;
-      l2 = l >> 1;
-      for (uint32_t i = 0; i < l2; ++i)
-      {
-        p1 = idx[*data++];
-        p2 = idx[*data++];
-        MSB_32_16_16_SET(_buffer32[i], p1, p2);
-      }
-      if (l & 1)
-      {
-        p1 = idx[*data++];
-        MSB_16_SET(_buffer16[l - 1], p1);
-      }
+      gfx_index8_to_be565(_buffer16, data, idx, l);
+      data += l;
 
       _spi_tran.tx_buffer = _buffer32;
       _spi_tran.length = l << 4;
@@ -788,15 +820,11 @@ void Arduino_ESP32SPIDMA::writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx,
     }
 
     uint32_t l;
-    uint16_t p;
     while (len)
     {
       l = (len > (ESP32SPIDMA_MAX_PIXELS_AT_ONCE >> 1)) ? (ESP32SPIDMA_MAX_PIXELS_AT_ONCE >> 1) : len;
-      for (uint32_t i = 0; i < l; ++i)
-      {
-        p = idx[*data++];
-        MSB_32_16_16_SET(_buffer32[i], p, p);
-      }
+      gfx_index8_to_be565_double(_buffer16, data, idx, l);
+      data += l;
 
       _spi_tran.tx_buffer = _buffer32;
       _spi_tran.length = l << 5;
@@ -824,32 +852,16 @@ void Arduino_ESP32SPIDMA::writeYCbCrPixels(uint8_t *yData, uint8_t *cbData, uint
     uint16_t *dest = _buffer16;
     uint16_t *dest2 = dest + w;
 
-    uint8_t pxCb, pxCr;
-    int16_t pxR, pxG, pxB, pxY;
-
     uint16_t out_bits = w << 5;
     bool poll_started = false;
     for (int row = 0; row < rows; ++row)
     {
-      for (int col = 0; col < cols; ++col)
-      {
-        pxCb = *cbData++;
-        pxCr = *crData++;
-        pxR = CR2R16[pxCr];
-        pxG = -CB2G16[pxCb] - CR2G16[pxCr];
-        pxB = CB2B16[pxCb];
-
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-        pxY = Y2I16[*yData++];
-        *dest++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        *dest2++ = CLIPRBE[pxY + pxR] | CLIPGBE[pxY + pxG] | CLIPBBE[pxY + pxB];
-      }
-      yData += w;
-      yData2 += w;
+      gfx_ycbcr_to_rgb565(dest, yData, cbData, crData, w, true);
+      gfx_ycbcr_to_rgb565(dest2, yData2, cbData, crData, w, true);
+      cbData += cols;
+      crData += cols;
+      yData += w << 1;
+      yData2 += w << 1;
 
       if (poll_started)
       {
@@ -43,6 +43,7 @@ public:
   void writePixels(uint16_t *data, uint32_t len) override;
 
   void writeBytes(uint8_t *data, uint32_t len) override;
+  void write16bitBeRGBBitmapR1(uint16_t *bitmap, int16_t w, int16_t h) override;
 
   void writeIndexedPixels(uint8_t *data, uint16_t *idx, uint32_t len) override;
   void writeIndexedPixelsDouble(uint8_t *data, uint16_t *idx, uint32_t len) override;
@@ -513,29 +513,14 @@ void Arduino_DSI_Display::drawYCbCrBitmap(int16_t x, int16_t y, uint8_t *yData,
     uint16_t *dest2 = dest + _fb_width;
     uint8_t *yData2 = yData + w;
 
-    uint8_t pxCb, pxCr;
-    int16_t pxR, pxG, pxB, pxY;
-
     for (int row = 0; row < rows; ++row)
     {
-      for (int col = 0; col < w;)
-      {
-        pxCb = *cbData++;
-        pxCr = *crData++;
-        pxR = CR2R16[pxCr];
-        pxG = -CB2G16[pxCb] - CR2G16[pxCr];
-        pxB = CB2B16[pxCb];
-        pxY = Y2I16[*yData++];
-        dest[col] = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        dest2[col++] = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData++];
-        dest[col] = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-        pxY = Y2I16[*yData2++];
-        dest2[col++] = CLIPR[pxY + pxR] | CLIPG[pxY + pxG] | CLIPB[pxY + pxB];
-      }
-      yData += w;
-      yData2 += w;
+      gfx_ycbcr_to_rgb565(dest, yData, cbData, crData, w, false);
+      gfx_ycbcr_to_rgb565(dest2, yData2, cbData, crData, w, false);
+      cbData += w >> 1;
+      crData += w >> 1;
+      yData += w << 1;
+      yData2 += w << 1;
       dest = dest2 + _fb_width;
       dest2 = dest + _fb_width;
     }
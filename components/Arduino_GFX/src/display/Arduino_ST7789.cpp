@@ -61,6 +61,7 @@ void Arduino_ST7789::setRotation(uint8_t r)
     r = ST7789_MADCTL_RGB;
     break;
   }
+  _madctl = r;
   _bus->beginWrite();
   _bus->writeC8D8(ST7789_MADCTL, r);
   _bus->endWrite();
@@ -104,6 +105,118 @@ void Arduino_ST7789::displayOff(void)
   delay(ST7789_SLPIN_DELAY);
 }
 
+/**************************************************************************/
+/*!
+    @brief   Enter sleep mode, the panel keeps its frame memory.
+             Only waits if the last sleepOut was less than ST7789_SLPOUT_DELAY ago
+*/
+/**************************************************************************/
+void Arduino_ST7789::sleepIn(void)
+{
+  unsigned long elapsed = millis() - _sleepMs;
+  if (elapsed < ST7789_SLPOUT_DELAY)
+  {
+    delay(ST7789_SLPOUT_DELAY - elapsed);
+  }
+  _bus->sendCommand(ST7789_SLPIN);
+  _sleepMs = millis();
+  delay(ST7789_SLEEP_CMD_DELAY);
+}
+
+/**************************************************************************/
+/*!
+    @brief   Leave sleep mode, the retained frame memory is shown again.
+             Only waits if the last sleepIn was less than ST7789_SLPIN_DELAY ago
+*/
+/**************************************************************************/
+void Arduino_ST7789::sleepOut(void)
+{
+  unsigned long elapsed = millis() - _sleepMs;
+  if (elapsed < ST7789_SLPIN_DELAY)
+  {
+    delay(ST7789_SLPIN_DELAY - elapsed);
+  }
+  _bus->sendCommand(ST7789_SLPOUT);
+  _sleepMs = millis();
+  delay(ST7789_SLEEP_CMD_DELAY);
+}
+
+/**************************************************************************/
+/*!
+    @brief   Define the vertical scroll area, in frame memory rows
+    @param   tfa  Top fixed area
+    @param   vsa  Vertical scroll area
+    @param   bfa  Bottom fixed area, tfa + vsa + bfa must be ST7789_TFTHEIGHT
+*/
+/**************************************************************************/
+void Arduino_ST7789::setScrollArea(uint16_t tfa, uint16_t vsa, uint16_t bfa)
+{
+  _scrollTFA = tfa;
+  _scrollVSA = vsa;
+  _bus->beginWrite();
+  _bus->writeCommand(ST7789_VSCRDEF);
+  _bus->write16(tfa);
+  _bus->write16(vsa);
+  _bus->write16(bfa);
+  _bus->endWrite();
+}
+
+/**************************************************************************/
+/*!
+    @brief   Set the frame memory row shown at the top of the scroll area
+    @param   vsp  Vertical scroll start address, tfa <= vsp < tfa + vsa
+*/
+/**************************************************************************/
+void Arduino_ST7789::setScrollStart(uint16_t vsp)
+{
+  _bus->beginWrite();
+  _bus->writeC8D16(ST7789_VSCRSADD, vsp);
+  _bus->endWrite();
+}
+
+// The frame memory rows run along the screen X axis when X and Y are exchanged
+bool Arduino_ST7789::isScrollHorizontal()
+{
+  return _madctl & ST7789_MADCTL_MV;
+}
+
+// Make the visible window the scroll area, the rest of the frame memory is fixed
+void Arduino_ST7789::scrollBegin()
+{
+  bool horiz = isScrollHorizontal();
+  uint16_t start = horiz ? _xStart : _yStart;
+  uint16_t len = horiz ? _width : _height;
+  uint16_t tfa = (_madctl & ST7789_MADCTL_MY) ? (ST7789_TFTHEIGHT - start - len) : start;
+
+  setScrollArea(tfa, len, ST7789_TFTHEIGHT - tfa - len);
+  setScrollStart(tfa);
+}
+
+/**************************************************************************/
+/*!
+    @brief   Shift the scroll area content, wrapping around its edges
+    @param   offset  Displacement in pixels towards larger screen coordinates
+                     along the scroll axis (X if isScrollHorizontal(), else Y)
+*/
+/**************************************************************************/
+void Arduino_ST7789::scrollTo(int16_t offset)
+{
+  // memory row = coordinate unless the row order is mirrored
+  int32_t v = (_madctl & ST7789_MADCTL_MY) ? offset : -offset;
+  v %= _scrollVSA;
+  if (v < 0)
+  {
+    v += _scrollVSA;
+  }
+  setScrollStart(_scrollTFA + v);
+}
+
+void Arduino_ST7789::scrollEnd()
+{
+  setScrollStart(0);
+  setScrollArea(0, ST7789_TFTHEIGHT, 0);
+}
+
 // Companion code to the above tables.  Reads and issues
 // a series of LCD commands stored in PROGMEM byte array.
 void Arduino_ST7789::tftInit()
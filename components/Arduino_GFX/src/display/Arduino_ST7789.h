@@ -15,6 +15,7 @@
 #define ST7789_RST_DELAY 120    ///< delay ms wait for reset finish
 #define ST7789_SLPIN_DELAY 120  ///< delay ms wait for sleep in finish
 #define ST7789_SLPOUT_DELAY 120 ///< delay ms wait for sleep out finish
+#define ST7789_SLEEP_CMD_DELAY 5 ///< delay ms before the next command after sleep in / out
 
 #define ST7789_NOP 0x00
 #define ST7789_SWRESET 0x01
@@ -37,8 +38,10 @@
 #define ST7789_RAMRD 0x2E
 
 #define ST7789_PTLAR 0x30
+#define ST7789_VSCRDEF 0x33
 #define ST7789_COLMOD 0x3A
 #define ST7789_MADCTL 0x36
+#define ST7789_VSCRSADD 0x37
 
 #define ST7789_MADCTL_MY 0x80
 #define ST7789_MADCTL_MX 0x40
@@ -127,6 +130,11 @@ public:
       bool ips = false, int16_t w = ST7789_TFTWIDTH, int16_t h = ST7789_TFTHEIGHT,
       uint8_t col_offset1 = 0, uint8_t row_offset1 = 0, uint8_t col_offset2 = 0, uint8_t row_offset2 = 0);
 
+  // address window commands, also used by Arduino_TFT_Static<Arduino_ST7789, ...>
+  static const uint8_t CMD_CASET = ST7789_CASET;
+  static const uint8_t CMD_RASET = ST7789_RASET;
+  static const uint8_t CMD_RAMWR = ST7789_RAMWR;
+
   bool begin(int32_t speed = GFX_NOT_DEFINED) override;
 
   void setRotation(uint8_t r) override;
@@ -137,8 +145,25 @@ public:
   void displayOn() override;
   void displayOff() override;
 
+  // hardware scroll, shifts the frame memory rows (ST7789_TFTHEIGHT) on the panel
+  void setScrollArea(uint16_t tfa, uint16_t vsa, uint16_t bfa);
+  void setScrollStart(uint16_t vsp);
+  bool isScrollHorizontal();
+  void scrollBegin();
+  void scrollTo(int16_t offset);
+  void scrollEnd();
+
+  // sleep in / out without waiting for the full settle time, the frame memory is retained
+  void sleepIn();
+  void sleepOut();
+
 protected:
   void tftInit() override;
 
+  uint8_t _madctl = ST7789_MADCTL_RGB;
+  uint16_t _scrollTFA = 0;
+  uint16_t _scrollVSA = ST7789_TFTHEIGHT;
+  unsigned long _sleepMs = 0; // millis() of the last sleepIn / sleepOut
+
 private:
 };
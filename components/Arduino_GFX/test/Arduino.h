@@ -0,0 +1,11 @@
+/*
+ * Minimal Arduino.h for building the kernel tests on the host.
+ */
+#ifndef _ARDUINO_H_
+#define _ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#endif // _ARDUINO_H_
@@ -0,0 +1,340 @@
+/*
+ * Host check of Arduino_PixelKernels against per-pixel reference loops.
+ *
+ * Covers every length up to 2 vector blocks and a few longer ones, with
+ * source and destination offset from their alignment. YCbCr is also
+ * checked over all 2^24 inputs against the lookup tables it replaced,
+ * test/YCbCr2RGB.h is that header as it was. The 90 degree rotation is
+ * checked band by band over every clip range of a few bitmap sizes. Not part of the component
+ * build, run from components/Arduino_GFX:
+ *   g++ -O2 -Wall -Itest -Isrc test/test_pixel_kernels.cpp src/Arduino_PixelKernels.cpp -o /tmp/test_pixel_kernels && /tmp/test_pixel_kernels
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "Arduino_PixelKernels.h"
+#include "YCbCr2RGB.h"
+
+#define BUF_PIXELS 1100
+#define GUARD 0xA5A5
+
+static const uint32_t lens[] = {127, 128, 129, 255, 1000};
+
+alignas(16) static uint8_t src_buf[BUF_PIXELS * 3 + 32];
+alignas(16) static uint16_t out_buf[BUF_PIXELS * 2 + 32];
+alignas(16) static uint16_t ref_buf[BUF_PIXELS * 2 + 32];
+alignas(16) static uint8_t alpha_buf[BUF_PIXELS + 32];
+static uint16_t palette[256];
+static uint32_t failures = 0;
+
+static uint16_t ref_be565(uint8_t r, uint8_t g, uint8_t b)
+{
+  uint16_t c = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3);
+  return (uint16_t)((c >> 8) | (c << 8));
+}
+
+// per channel blend with the 5-bit alpha the kernel uses, rounded toward -inf
+static int32_t ref_blend_channel(int32_t f, int32_t b, int32_t a)
+{
+  return b + (((f - b) * a) >> 5);
+}
+
+static uint16_t ref_blend565(uint16_t fg, uint16_t bg, uint8_t alpha)
+{
+  int32_t a = (alpha + 4) >> 3;
+  int32_t r = ref_blend_channel(fg >> 11, bg >> 11, a);
+  int32_t g = ref_blend_channel((fg >> 5) & 0x3F, (bg >> 5) & 0x3F, a);
+  int32_t b = ref_blend_channel(fg & 0x1F, bg & 0x1F, a);
+  return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+// 8.8 fixed point BT.601, the arithmetic gfx_ycbcr_to_rgb565() is meant to do
+static int32_t ref_clip8(int32_t v)
+{
+  return (v < 0) ? 0 : ((v > 255) ? 255 : v);
+}
+
+static uint16_t ref_ycbcr565(uint8_t y, uint8_t cb, uint8_t cr)
+{
+  int32_t l = 298 * (y - 16);
+  int32_t u = cb - 128;
+  int32_t v = cr - 128;
+  int32_t r = ref_clip8((l + 409 * v + 128) >> 8);
+  int32_t g = ref_clip8((l - 100 * u - 208 * v + 128) >> 8);
+  int32_t b = ref_clip8((l + 516 * u + 128) >> 8);
+  return (uint16_t)(((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3));
+}
+
+static void check(const char *name, uint32_t len, uint32_t src_off, uint32_t dst_off, const uint16_t *out, const uint16_t *ref, uint32_t n)
+{
+  // n output pixels plus one guard pixel that must stay untouched
+  if (memcmp(out, ref, (n + 1) * sizeof(uint16_t)) != 0)
+  {
+    if (failures < 20)
+    {
+      printf("FAIL %s len %u src +%u dst +%u\n", name, len, src_off, dst_off);
+    }
+    ++failures;
+  }
+}
+
+static void run(uint32_t len, uint32_t src_off, uint32_t dst_off)
+{
+  uint16_t *out = out_buf + dst_off;
+  uint16_t *ref = ref_buf + dst_off;
+  uint32_t i;
+
+  // gfx_swap16, src_off in pixels
+  const uint16_t *s16 = (const uint16_t *)src_buf + src_off;
+  for (i = 0; i < len; i++)
+  {
+    ref[i] = (uint16_t)((s16[i] >> 8) | (s16[i] << 8));
+  }
+  ref[len] = out[len] = GUARD;
+  gfx_swap16(out, s16, len);
+  check("swap16", len, src_off, dst_off, out, ref, len);
+
+  // gfx_swap16 in place
+  memcpy(out, s16, len * sizeof(uint16_t));
+  gfx_swap16(out, out, len);
+  check("swap16 in place", len, src_off, dst_off, out, ref, len);
+
+  // gfx_index8_to_be565, src_off in bytes
+  const uint8_t *s8 = src_buf + src_off;
+  for (i = 0; i < len; i++)
+  {
+    ref[i] = (uint16_t)((palette[s8[i]] >> 8) | (palette[s8[i]] << 8));
+  }
+  ref[len] = out[len] = GUARD;
+  gfx_index8_to_be565(out, s8, palette, len);
+  check("index8", len, src_off, dst_off, out, ref, len);
+
+  // gfx_index8_to_be565_double
+  for (i = 0; i < len; i++)
+  {
+    ref[i * 2] = ref[i * 2 + 1] = (uint16_t)((palette[s8[i]] >> 8) | (palette[s8[i]] << 8));
+  }
+  ref[len * 2] = out[len * 2] = GUARD;
+  gfx_index8_to_be565_double(out, s8, palette, len);
+  check("index8 double", len, src_off, dst_off, out, ref, len * 2);
+
+  // gfx_rgb888_to_be565
+  for (i = 0; i < len; i++)
+  {
+    ref[i] = ref_be565(s8[i * 3], s8[i * 3 + 1], s8[i * 3 + 2]);
+  }
+  ref[len] = out[len] = GUARD;
+  gfx_rgb888_to_be565(out, s8, len);
+  check("rgb888", len, src_off, dst_off, out, ref, len);
+
+  // gfx_blend565, fg offset by src_off, bg taken from the second half of the source
+  const uint16_t *fg = (const uint16_t *)src_buf + src_off;
+  const uint16_t *bg = (const uint16_t *)src_buf + BUF_PIXELS / 2 + dst_off;
+  const uint8_t *alpha = alpha_buf + src_off;
+  for (i = 0; i < len; i++)
+  {
+    ref[i] = ref_blend565(fg[i], bg[i], alpha[i]);
+  }
+  ref[len] = out[len] = GUARD;
+  gfx_blend565(out, fg, bg, alpha, len);
+  check("blend565", len, src_off, dst_off, out, ref, len);
+
+  // gfx_ycbcr_to_rgb565, one Cb / Cr sample per 2 pixels, odd widths included
+  const uint8_t *cb = src_buf + 1200 + src_off;
+  const uint8_t *cr = src_buf + 1800 + dst_off;
+  for (i = 0; i < len; i++)
+  {
+    ref[i] = ref_ycbcr565(s8[i], cb[i >> 1], cr[i >> 1]);
+  }
+  ref[len] = out[len] = GUARD;
+  gfx_ycbcr_to_rgb565(out, s8, cb, cr, len, false);
+  check("ycbcr", len, src_off, dst_off, out, ref, len);
+
+  for (i = 0; i < len; i++)
+  {
+    ref[i] = (uint16_t)((ref[i] >> 8) | (ref[i] << 8));
+  }
+  gfx_ycbcr_to_rgb565(out, s8, cb, cr, len, true);
+  check("ycbcr be", len, src_off, dst_off, out, ref, len);
+}
+
+// all 2^24 YCbCr inputs against the former tables, every channel within 1 LSB
+static void check_ycbcr_tables()
+{
+  alignas(16) static uint8_t y[256];
+  alignas(16) static uint8_t cb[128];
+  alignas(16) static uint8_t cr[128];
+  alignas(16) static uint16_t out[256];
+  uint32_t i, u, v;
+  int32_t l, pxR, pxG, pxB;
+  uint16_t t;
+
+  for (i = 0; i < 256; i++)
+  {
+    y[i] = i;
+  }
+
+  for (u = 0; u < 256; u++)
+  {
+    for (v = 0; v < 256; v++)
+    {
+      memset(cb, u, sizeof(cb));
+      memset(cr, v, sizeof(cr));
+      gfx_ycbcr_to_rgb565(out, y, cb, cr, 256, false);
+
+      // the table lookup of the former converters
+      pxR = CR2R16[v];
+      pxG = -CB2G16[u] - CR2G16[v];
+      pxB = CB2B16[u];
+      for (i = 0; i < 256; i++)
+      {
+        l = Y2I16[i];
+        t = CLIPR[l + pxR] | CLIPG[l + pxG] | CLIPB[l + pxB];
+        if (abs((t >> 11) - (out[i] >> 11)) > 1
+            || abs(((t >> 5) & 0x3F) - ((out[i] >> 5) & 0x3F)) > 1
+            || abs((t & 0x1F) - (out[i] & 0x1F)) > 1)
+        {
+          if (failures < 20)
+          {
+            printf("FAIL ycbcr table %u %u %u: 0x%04X != 0x%04X\n", i, u, v, out[i], t);
+          }
+          ++failures;
+        }
+      }
+    }
+  }
+}
+
+// bands of clipped 90 degree rotations against the per-pixel mapping
+static void check_rotate_r1()
+{
+  static const int16_t sizes[] = {1, 2, 7, 8, 9, 33};
+  static uint16_t bitmap[33 * 33];
+  static uint16_t out[33 * 8 + 1];
+  int16_t w, h, c0, c1, r, rows, c, i;
+
+  for (i = 0; i < 33 * 33; i++)
+  {
+    bitmap[i] = (uint16_t)rand();
+  }
+
+  for (uint32_t wi = 0; wi < sizeof(sizes) / sizeof(sizes[0]); wi++)
+  {
+    for (uint32_t hi = 0; hi < sizeof(sizes) / sizeof(sizes[0]); hi++)
+    {
+      w = sizes[wi];
+      h = sizes[hi];
+      for (c0 = 0; c0 < h; c0++)
+      {
+        for (c1 = c0 + 1; c1 <= h; c1++)
+        {
+          for (r = 0; r < w; r++)
+          {
+            rows = ((w - r) > 8) ? 8 : (w - r);
+            out[rows * (c1 - c0)] = GUARD;
+            gfx_rotate_r1(out, bitmap, w, h, c0, c1, r, rows);
+            for (i = 0; i < rows; i++)
+            {
+              for (c = c0; c < c1; c++)
+              {
+                if (out[i * (c1 - c0) + (c - c0)] != bitmap[(h - 1 - c) * w + r + i])
+                {
+                  if (failures < 20)
+                  {
+                    printf("FAIL rotate_r1 %dx%d c %d-%d r %d+%d\n", w, h, c0, c1, r, i);
+                  }
+                  ++failures;
+                }
+              }
+            }
+            if (out[rows * (c1 - c0)] != GUARD)
+            {
+              printf("FAIL rotate_r1 %dx%d guard\n", w, h);
+              ++failures;
+            }
+          }
+        }
+      }
+    }
+  }
+}
+
+int main()
+{
+  uint32_t i, len, src_off, dst_off;
+
+  srand(1);
+  for (i = 0; i < sizeof(src_buf); i++)
+  {
+    src_buf[i] = (uint8_t)rand();
+  }
+  for (i = 0; i < 256; i++)
+  {
+    palette[i] = (uint16_t)rand();
+  }
+  // every 4th alpha is one of the 0 / 255 shortcuts
+  for (i = 0; i < sizeof(alpha_buf); i++)
+  {
+    alpha_buf[i] = (i & 3) ? (uint8_t)rand() : ((i & 4) ? 255 : 0);
+  }
+
+  // offsets 0 - 7 cover every 4 and 16 byte misalignment of the pixels
+  for (src_off = 0; src_off < 8; src_off++)
+  {
+    for (dst_off = 0; dst_off < 8; dst_off++)
+    {
+      for (len = 0; len <= 33; len++)
+      {
+        run(len, src_off, dst_off);
+      }
+      for (i = 0; i < sizeof(lens) / sizeof(lens[0]); i++)
+      {
+        run(lens[i], src_off, dst_off);
+      }
+    }
+  }
+
+  // the whole 24-bit color space through the rgb888 word path
+  alignas(16) static uint8_t rgb[256 * 3];
+  for (uint32_t rg = 0; rg < 0x10000; rg++)
+  {
+    for (i = 0; i < 256; i++)
+    {
+      rgb[i * 3] = rg >> 8;
+      rgb[i * 3 + 1] = rg & 0xFF;
+      rgb[i * 3 + 2] = i;
+    }
+    gfx_rgb888_to_be565(out_buf, rgb, 256);
+    for (i = 0; i < 256; i++)
+    {
+      if (out_buf[i] != ref_be565(rg >> 8, rg & 0xFF, i))
+      {
+        printf("FAIL rgb888 0x%02X%02X%02X\n", rg >> 8, rg & 0xFF, i);
+        ++failures;
+        break;
+      }
+    }
+  }
+
+  check_ycbcr_tables();
+  check_rotate_r1();
+
+  // every alpha of the single pixel blend for a spread of color pairs
+  for (uint32_t fg = 0; fg < 0x10000; fg += 251)
+  {
+    for (uint32_t bg = 0; bg < 0x10000; bg += 241)
+    {
+      for (i = 0; i < 256; i++)
+      {
+        if (gfx_blend565(fg, bg, i) != ref_blend565(fg, bg, i))
+        {
+          printf("FAIL blend565 0x%04X 0x%04X %u\n", fg, bg, i);
+          ++failures;
+        }
+      }
+    }
+  }
+
+  printf("%s, %u failures\n", failures ? "FAILED" : "OK", failures);
+  return failures ? 1 : 0;
+}
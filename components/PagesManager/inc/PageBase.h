@@ -24,12 +24,20 @@
 #define __PAGE_BASE_H
 
 #include "lvgl.h"
+#include <type_traits>
 
 /* Generate stash area data */
 #define PAGE_STASH_MAKE(data) {&(data), sizeof(data)}
 
 /* Get the data in the stash area */
-#define PAGE_STASH_POP(data)  this->StashPop(&(data), sizeof(data))
+#define PAGE_STASH_POP(data)  this->StashPop(&(data))
+
+/* Stash data up to this size is kept inside the page */
+#define PAGE_STASH_INLINE_SIZE 32 //[byte]
+
+/* Shared blocks for the larger stash data, lv_mem is used beyond them */
+#define PAGE_STASH_POOL_BLOCK_SIZE 128 //[byte]
+#define PAGE_STASH_POOL_BLOCK_NUM  4
 
 #define PAGE_ANIM_TIME_DEFAULT 500 //[ms]
 
@@ -62,6 +70,19 @@ public:
         uint32_t size;
     } Stash_t;
 
+    /* Typed stash data area, the data is copied when the page is switched */
+    template<typename T>
+    struct Stash : Stash_t
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Stash data must be trivially copyable");
+
+        explicit Stash(const T& data)
+        {
+            ptr = (void*)&data;
+            size = sizeof(T);
+        }
+    };
+
     /* Page switching animation properties */
     typedef struct
     {
@@ -70,6 +91,51 @@ public:
         lv_anim_path_cb_t Path;
     } AnimAttr_t;
 
+    /* Page cache statistics */
+    typedef struct
+    {
+        uint32_t MemSize;   // Approximate lv_mem footprint of the root subtree [byte]
+        uint32_t LastShow;  // Appear sequence number, used for LRU eviction
+        uint32_t Hit;       // Times shown from the cache
+        uint32_t Miss;      // Times the view had to be loaded
+    } CacheInfo_t;
+
+    /* Lifecycle callbacks timed by the profiler */
+    typedef enum
+    {
+        PAGE_PROFILE_LOAD,              // onViewLoad, onViewLoadStep and onViewDidLoad
+        PAGE_PROFILE_WILL_APPEAR,
+        PAGE_PROFILE_DID_APPEAR,
+        PAGE_PROFILE_WILL_DISAPPEAR,
+        PAGE_PROFILE_DID_DISAPPEAR,
+        PAGE_PROFILE_UNLOAD,            // onViewUnload and onViewDidUnload
+        _PAGE_PROFILE_LAST
+    } ProfileCall_t;
+
+    /* Duration of a lifecycle callback */
+    typedef struct
+    {
+        uint32_t Count;
+        uint32_t Last;      // [us]
+        uint32_t Max;       // [us]
+        uint32_t Total;     // [us]
+        uint32_t Pending;   // Parts of an unfinished call, e.g. load steps [us]
+    } ProfileTime_t;
+
+    /* Page profiler statistics */
+    typedef struct
+    {
+        ProfileTime_t Call[_PAGE_PROFILE_LAST];
+        uint32_t AnimTime;      // Wall time of the last switch animation [ms]
+        uint32_t AnimFrames;    // Frames rendered during it
+        uint32_t AnimFrameMax;  // Longest frame render time during it [ms]
+        int32_t MemLoad;        // lv_mem used by the last load [byte]
+        int32_t MemDelta;       // lv_mem used after the last unload minus before its load [byte]
+        uint32_t MemUsed;       // lv_mem used before the last load [byte]
+        uint32_t LoadTick;      // Tick the view was loaded
+        uint32_t Resident;      // Time the view spent in memory [ms]
+    } ProfileInfo_t;
+
 public:
     lv_obj_t* _root;       // UI root node
     PageManager* _Manager; // Page manager pointer
@@ -85,15 +151,28 @@ public:
 
         bool IsDisableAutoCache;    // Whether it is automatic cache management
         bool IsCached;              // Cache enable
+        bool IsPreloaded;           // View was built ahead, drag not configured yet
+
+        bool IsLoadStep;            // View is built by onViewLoadStep
+        bool IsLoadProgressive;     // Show the view before the steps are finished
+        bool IsLoading;             // Steps are not finished
+
+        void (*Destroy)(PageBase* base); // Frees the page, nullptr = delete
+        lv_group_t* Group;          // Focus group of the view
 
         Stash_t Stash;              // Stash area
+        alignas(8) uint8_t StashInline[PAGE_STASH_INLINE_SIZE]; // Storage of the small stash data
         State_t State;              // Page state
 
+        CacheInfo_t Cache;          // Cache statistics
+        ProfileInfo_t Profile;      // Profiler statistics
+
         /* Animation state  */
         struct
         {
             bool IsEnter;           // Whether it is the entering party
             bool IsBusy;            // Whether the animation is playing
+            lv_obj_t* Snapshot;     // Image animated in place of the root
             AnimAttr_t Attr;        // Animation properties
         } Anim;
     } priv;
@@ -107,6 +186,9 @@ public:
     /* Page load start */
     virtual void onViewLoad() {}
 
+    /* Page load in steps, called after onViewLoad until it returns true */
+    virtual bool onViewLoadStep() { return true; }
+
     /* Page load end */
     virtual void onViewDidLoad() {}
 
@@ -134,6 +216,9 @@ public:
     /* Set whether to enable automatic cache */
     void SetCustomAutoCacheEnable(bool en);
 
+    /* Set whether to build the view in steps, and whether to show it before it is finished */
+    void SetCustomLoadStepEnable(bool en, bool progressive = false);
+
     /* Set custom animation properties  */
     void SetCustomLoadAnimType(
         uint8_t animType,
@@ -143,6 +228,22 @@ public:
 
     /* Pop the data from stash area */
     bool StashPop(void* ptr, uint32_t size);
+
+    template<typename T>
+    bool StashPop(T* data)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "Stash data must be trivially copyable");
+        return StashPop(data, sizeof(T));
+    }
+
+private:
+    friend class PageManager;
+
+    /* Copy the data into the stash area */
+    bool StashSave(const Stash_t* stash);
+
+    /* Free the stash area */
+    void StashRelease();
 };
 
 #endif // ! __PAGE_BASE_H
@@ -25,9 +25,33 @@
 
 #include "PageBase.h"
 #include "PageFactory.h"
+#include "PageRegistry.h"
 #include <stdio.h>
+#include <string.h>
 #include <vector>
-#include <stack>
+#include <unordered_map>
+
+/* ID of a page name that was never registered */
+#define PAGE_ID_NONE 0xFFFF
+
+/* Default budget of the cached page views, 0 = unlimited */
+#define PAGE_CACHE_BUDGET_DEFAULT 0 //[byte]
+
+/* Period of the idle preload timer, one view is built per period */
+#define PAGE_PRELOAD_PERIOD 50 //[ms]
+
+/* Time the lifecycle callbacks, switch animations and view memory of the pages */
+#ifndef PAGE_PROFILER_ENABLE
+#define PAGE_PROFILER_ENABLE 1
+#endif
+
+/* Time the onViewLoadStep calls may take per frame */
+#define PAGE_LOAD_STEP_BUDGET 8 //[ms]
+
+/* Navigation requests waiting for the running page switch,
+ * stash data larger than PAGE_STASH_POOL_BLOCK_SIZE is queued in lv_mem
+ */
+#define PAGE_NAV_QUEUE_SIZE 4
 
 class PageManager
 {
@@ -120,15 +144,42 @@ public:
         AnimValue_t pop;
     } LoadAnimAttr_t;
 
+    /* Page cache statistics */
+    typedef struct
+    {
+        uint32_t Budget;    // Cache budget, 0 = unlimited [byte]
+        uint32_t MemUsage;  // Total size of the cached views [byte]
+        uint32_t Hit;       // Pages shown from the cache
+        uint32_t Miss;      // Pages loaded
+        uint32_t Evict;     // Pages unloaded to stay within budget
+    } CacheStat_t;
+
+    /* Panel hardware scroll, shifts the pixels already on the panel */
+    typedef struct
+    {
+        RootDragDir_t dir;                  // Axis the panel content is shifted along
+        void (*begin)(void);                // Make the screen the scroll area
+        void (*scroll)(int32_t offset);     // Shift the content towards larger coordinates [px]
+        void (*end)(void);                  // Restore the unscrolled panel
+    } ScrollBackend_t;
+
 public:
     PageManager(PageFactory* factory = nullptr);
     ~PageManager();
 
     /* Loader */
     bool Install(const char* className, const char* appName);
+    bool Install(uint32_t classID, const char* appName);
+    template<class T>
+    bool Install(const char* appName)
+    {
+        return InstallCheck(appName)
+               && InstallPage(PageStorage<T>::Create(), PageStorage<T>::Destroy, appName);
+    }
     bool Uninstall(const char* appName);
     bool Register(PageBase* base, const char* name);
     bool Unregister(const char* name);
+    uint16_t GetPageID(const char* name);
 
     /* Router */
     bool Replace(const char* name, const PageBase::Stash_t* stash = nullptr);
@@ -137,6 +188,18 @@ public:
     bool BackHome();
     const char* GetPagePrevName();
 
+    /* Typed stash, e.g. Push("Page", PageBase::Stash<Param_t>(param)) */
+    template<typename T>
+    bool Replace(const char* name, const PageBase::Stash<T>& stash)
+    {
+        return Replace(name, static_cast<const PageBase::Stash_t*>(&stash));
+    }
+    template<typename T>
+    bool Push(const char* name, const PageBase::Stash<T>& stash)
+    {
+        return Push(name, static_cast<const PageBase::Stash_t*>(&stash));
+    }
+
     /* Global Animation */
     void SetGlobalLoadAnimType(
         LoadAnim_t anim = LOAD_ANIM_OVER_LEFT,
@@ -149,14 +212,61 @@ public:
         _RootDefaultStyle = style;
     }
 
+    /* Animate a snapshot of the pages instead of their views */
+    void SetSnapshotAnimEnable(bool en)
+    {
+        _AnimState.IsSnapshotEnable = en;
+    }
+
+    /* Finish the running switch animation at once when a request is queued */
+    void SetNavFastForward(bool en)
+    {
+        _NavQueue.IsFastForward = en;
+    }
+
+    /* Give every page its own focus group, swapped in when the page appears */
+    void SetFocusGroupEnable(bool en)
+    {
+        _AnimState.IsFocusGroupEnable = en;
+    }
+
+    /* Slide the MOVE animations along the backend axis with the panel scroll, nullptr to disable */
+    void SetScrollBackend(const ScrollBackend_t* backend)
+    {
+        _ScrollState.Backend = backend;
+    }
+
+    /* Cache */
+    void SetCacheBudget(uint32_t size);
+    uint32_t GetCacheMemUsage();
+    void GetCacheStat(CacheStat_t* stat);
+    bool GetPageCacheInfo(const char* name, PageBase::CacheInfo_t* info);
+    void DumpCacheInfo();
+
+    /* Profiler */
+    bool GetPageProfile(const char* name, PageBase::ProfileInfo_t* info);
+    void DumpProfile();
+    void SetProfileOverlayEnable(bool en);
+
+    /* Preload */
+    bool Preload(const char* name);
+    void SetPreloadHint(const char* name, const char* nextName);
+
 private:
+    /* Loader */
+    bool InstallCheck(const char* appName);
+    bool InstallPage(PageBase* base, PageRegistry::DestroyFunc_t destroy, const char* appName);
+
     /* Page Pool */
     PageBase* FindPageInPool(const char* name);
+    uint16_t NameIntern(const char* name);
 
     /* Page Stack */
     PageBase* FindPageInStack(const char* name);
     PageBase* GetStackTop();
     PageBase* GetStackTopAfter();
+    void StackPush(PageBase* base);
+    void StackPop();
     void SetStackClear(bool keepBottom = false);
     bool FourceUnload(PageBase* base);
 
@@ -171,6 +281,8 @@ private:
         return (anim >= LOAD_ANIM_MOVE_LEFT && anim <= LOAD_ANIM_MOVE_BOTTOM);
     }
     void AnimDefaultInit(lv_anim_t* a);
+    bool AnimSnapshotCreate(PageBase* base);
+    void AnimSnapshotRelease(PageBase* base);
     bool GetCurrentLoadAnimAttr(LoadAnimAttr_t* attr)
     {
         return GetLoadAnimAttr(GetCurrentLoadAnimType(), attr);
@@ -186,6 +298,53 @@ private:
     static void onRootAsyncLeave(void* base);
     void RootEnableDrag(lv_obj_t* root);
     static void RootGetDragPredict(lv_coord_t* x, lv_coord_t* y);
+    void RootMoveForeground(PageBase* base);
+
+    /* Cache */
+    bool CacheCanEvict(PageBase* base);
+    bool CacheIsDragBottom(PageBase* base);
+    void CacheEvict(uint32_t reserve = 0);
+    static uint32_t CacheGetMemUsed();
+    static uint32_t CacheGetObjSize(lv_obj_t* obj);
+
+    /* Preload */
+    static void onPreloadTimer(lv_timer_t* timer);
+    void PreloadHintCheck(PageBase* base);
+    bool PreloadExecute(PageBase* base);
+
+    /* Profiler */
+    static uint32_t ProfileTick();
+    void ProfileRecord(PageBase* base, PageBase::ProfileCall_t call, uint32_t tickStart, bool isEnd = true);
+    void ProfileLoadBegin(PageBase* base);
+    void ProfileUnload(PageBase* base);
+    void ProfileSwitchBegin();
+    void ProfileAnimEnd(PageBase* base);
+    void ProfileOverlayUpdate();
+    static void onProfileMonitor(lv_disp_drv_t* disp_drv, uint32_t time, uint32_t px);
+    static void onProfileUnloadDone(void* base);
+
+    /* Focus */
+    lv_group_t* FocusGroupBegin(PageBase* base);
+    void FocusGroupEnd(lv_group_t* prev);
+    void FocusGroupSwap(PageBase* base);
+    void FocusGroupDelete(PageBase* base);
+
+    /* Scroll */
+    bool ScrollBegin();
+    void ScrollEnd();
+    static void onScrollAnimExec(void* var, int32_t v);
+    void ScrollUpdate(int32_t pos);
+    void ScrollInvalidate(int32_t start, int32_t end);
+
+    /* Navigation queue */
+    struct NavReq_t;
+    bool NavEnqueue(uint8_t type, const char* name, const PageBase::Stash_t* stash);
+    void NavQueueResume();
+    static void onNavQueueDrain(void* manager);
+    void NavQueueDrain();
+    bool NavExecute(const NavReq_t* req);
+    void NavReqRelease(NavReq_t* req);
+    void SwitchFastForward();
 
     /* Switch */
     bool SwitchTo(PageBase* base, bool isEnterAct, const PageBase::Stash_t* stash = nullptr);
@@ -193,6 +352,7 @@ private:
     void SwitchAnimCreate(PageBase* base);
     void SwitchAnimTypeUpdate(PageBase* base);
     bool SwitchReqCheck();
+    void SwitchExecute();
     bool SwitchAnimStateCheck();
 
     /* State */
@@ -202,6 +362,12 @@ private:
     PageBase::State_t StateWillDisappearExecute(PageBase* base);
     PageBase::State_t StateDidDisappearExecute(PageBase* base);
     PageBase::State_t StateUnloadExecute(PageBase* base);
+    void ViewLoadBegin(PageBase* base);
+    bool ViewLoadStep(PageBase* base, uint32_t tickStart);
+    void ViewLoadEnd(PageBase* base);
+    void LoadStepTimerResume();
+    static void onLoadStepTimer(lv_timer_t* timer);
+    void ViewDragUpdate(PageBase* base);
     void StateUpdate(PageBase* base);
     PageBase::State_t GetState()
     {
@@ -210,14 +376,45 @@ private:
 
 private:
 
+    /* FNV-1a hash of a page name */
+    struct NameHash
+    {
+        size_t operator()(const char* name) const
+        {
+            uint32_t hash = 2166136261UL;
+            while (*name)
+            {
+                hash = (hash ^ (uint8_t)*name++) * 16777619UL;
+            }
+            return hash;
+        }
+    };
+
+    struct NameEqual
+    {
+        bool operator()(const char* a, const char* b) const
+        {
+            return strcmp(a, b) == 0;
+        }
+    };
+
     /* Page factory */
     PageFactory* _Factory;
 
+    /* Interned page names, a name keeps its ID after it was unregistered */
+    std::unordered_map<const char*, uint16_t, NameHash, NameEqual> _PageIDMap;
+
+    /* Registered pages indexed by ID, nullptr if not registered */
+    std::vector<PageBase*> _PageTable;
+
     /* Page pool */
     std::vector<PageBase*> _PagePool;
 
     /* Page stack */
-    std::stack<PageBase*> _PageStack;
+    std::vector<PageBase*> _PageStack;
+
+    /* Stack position + 1 indexed by ID, 0 if not in the stack */
+    std::vector<uint16_t> _PageStackIndex;
 
     /* Previous page */
     PageBase* _PagePrev;
@@ -231,6 +428,8 @@ private:
         bool IsSwitchReq;              // Has switch request
         bool IsBusy;                   // Is switching
         bool IsEntering;               // Is in entering action
+        bool IsSnapshotEnable;         // Animate snapshots of the pages
+        bool IsFocusGroupEnable;       // Pages have their own focus group
 
         PageBase::AnimAttr_t Current;  // Current animation properties
         PageBase::AnimAttr_t Global;   // Global animation properties
@@ -238,6 +437,92 @@ private:
 
     /* Root style */
     lv_style_t* _RootDefaultStyle;
+
+    /* Page cache status */
+    struct
+    {
+        uint32_t Budget;               // Max size of the cached views, 0 = unlimited
+        uint32_t ShowSeq;              // Appear sequence counter
+        uint32_t Hit;                  // Pages shown from the cache
+        uint32_t Miss;                 // Pages loaded
+        uint32_t Evict;                // Pages unloaded to stay within budget
+    } _CacheState;
+
+    /* Navigation hint, NextName is likely shown after page ID */
+    typedef struct
+    {
+        uint16_t ID;                        // Page ID of the shown page
+        const char* NextName;               // Interned name, owned by _PageIDMap
+    } PreloadHint_t;
+
+    /* Page preload status */
+    struct
+    {
+        std::vector<PageBase*> Queue;       // Pages waiting to be built
+        std::vector<PreloadHint_t> Hints;   // Navigation graph
+        lv_timer_t* Timer;                  // Idle build timer
+        PageBase* Current;                  // Page being built in steps
+    } _Preload;
+
+    /* Timer driving the pages built in steps */
+    lv_timer_t* _LoadStepTimer;
+
+    /* Navigation request type */
+    typedef enum
+    {
+        NAV_PUSH,
+        NAV_POP,
+        NAV_REPLACE,
+        NAV_BACK_HOME,
+    } NavType_t;
+
+    /* Navigation request made during a page switch */
+    struct NavReq_t
+    {
+        uint8_t Type;                       // NavType_t
+        const char* Name;                   // Interned page name, nullptr for POP and BACK_HOME
+        bool HasStash;
+        uint32_t StashSize;
+        alignas(8) uint8_t Stash[PAGE_STASH_POOL_BLOCK_SIZE]; // Copy of the stash data
+        void* StashHeap;                    // lv_mem copy of a larger stash, nullptr if unused
+    };
+
+    /* Navigation queue status */
+    struct
+    {
+        NavReq_t Req[PAGE_NAV_QUEUE_SIZE];  // Oldest first
+        uint8_t Count;
+        bool IsDrainPending;                // Drain is scheduled by lv_async_call
+        bool IsDraining;                    // Requests are executed from the queue
+        bool IsFastForward;                 // Skip the running switch animation
+    } _NavQueue;
+
+    /* Panel scroll status */
+    struct
+    {
+        const ScrollBackend_t* Backend;     // nullptr = disabled
+        bool IsActive;                      // The running switch scrolls the panel
+        int32_t Start;                      // Start position of the entering root
+        int32_t DrawStart;                  // Part of the entering root drawn so far,
+        int32_t DrawEnd;                    // in root coordinates
+    } _ScrollState;
+
+    /* Profiler status */
+    struct
+    {
+        lv_obj_t* Overlay;                  // Label showing the last switch
+        uint32_t FrameStart;                // Frame count at the switch start
+        uint32_t TickStart;                 // Tick of the switch start
+    } _Profile;
+
+    /* Rendered frames, counted by the display monitor callback */
+    static struct ProfileMonitor_t
+    {
+        void (*Prev)(lv_disp_drv_t* disp_drv, uint32_t time, uint32_t px);
+        bool IsHooked;
+        uint32_t FrameCnt;
+        uint32_t FrameTimeMax;              // Since the switch began [ms]
+    } _ProfileMonitor;
 };
 
 #endif
@@ -0,0 +1,111 @@
+#ifndef __PAGE_REGISTRY_H
+#define __PAGE_REGISTRY_H
+
+#include "PageBase.h"
+#include <new>
+
+/**
+  * Register a page class under a hashed name, e.g. in the page source file:
+  *   PAGE_REGISTER(Page::Template, Template);
+  * PageManager::Install("Template", ...) then finds it without the factory.
+  * Nothing else references the object file of such a page, make sure it is
+  * linked (Install<T>() does it, so does a whole-archive link).
+  */
+#define PAGE_REGISTER(type, name) \
+static PageRegistry::Entry _PageRegistryEntry_##name( \
+    PageRegistry::NameHash(#name), \
+    PageStorage<type>::Create, \
+    PageStorage<type>::Destroy \
+)
+
+/* Static storage for one page of the class, more instances are allocated */
+template<class T>
+class PageStorage
+{
+public:
+    static PageBase* Create()
+    {
+        if (IsUsed)
+        {
+            return new T;
+        }
+
+        IsUsed = true;
+        return new (Buffer) T;
+    }
+
+    static void Destroy(PageBase* base)
+    {
+        if ((void*)base == (void*)Buffer)
+        {
+            base->~PageBase();
+            IsUsed = false;
+        }
+        else
+        {
+            delete base;
+        }
+    }
+
+private:
+    alignas(T) static inline uint8_t Buffer[sizeof(T)];
+    static inline bool IsUsed;
+};
+
+class PageRegistry
+{
+public:
+    typedef PageBase* (*CreateFunc_t)();
+    typedef void (*DestroyFunc_t)(PageBase* base);
+
+    /* Registered page class, links itself into the registry when constructed */
+    struct Entry
+    {
+        Entry(uint32_t id, CreateFunc_t create, DestroyFunc_t destroy)
+            : ID(id)
+            , Create(create)
+            , Destroy(destroy)
+            , Next(GetHead())
+        {
+            GetHead() = this;
+        }
+
+        uint32_t ID;            // NameHash of the class name
+        CreateFunc_t Create;
+        DestroyFunc_t Destroy;
+        Entry* Next;
+    };
+
+    /* FNV-1a hash of a class name, usable at compile time */
+    static constexpr uint32_t NameHash(const char* name)
+    {
+        uint32_t hash = 2166136261u;
+        while (*name)
+        {
+            hash = (hash ^ (uint8_t)*name++) * 16777619u;
+        }
+        return hash;
+    }
+
+    static const Entry* Find(uint32_t id)
+    {
+        for (const Entry* entry = GetHead(); entry != nullptr; entry = entry->Next)
+        {
+            if (entry->ID == id)
+            {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    /* Function local, the entries may be constructed before any other static */
+    static Entry*& GetHead()
+    {
+        static Entry* head = nullptr;
+        return head;
+    }
+};
+
+#endif // !__PAGE_REGISTRY_H
@@ -23,6 +23,45 @@
 #include "PageBase.h"
 #include "PageManagerLog.h"
 
+/* Blocks shared by the stash data larger than PAGE_STASH_INLINE_SIZE */
+static struct
+{
+    alignas(8) uint8_t Block[PAGE_STASH_POOL_BLOCK_NUM][PAGE_STASH_POOL_BLOCK_SIZE];
+    uint32_t UsedMask;
+} StashPool;
+
+static void* StashPoolAlloc(uint32_t size)
+{
+    if (size <= PAGE_STASH_POOL_BLOCK_SIZE)
+    {
+        for (int i = 0; i < PAGE_STASH_POOL_BLOCK_NUM; i++)
+        {
+            if (!(StashPool.UsedMask & (1UL << i)))
+            {
+                StashPool.UsedMask |= (1UL << i);
+                return StashPool.Block[i];
+            }
+        }
+    }
+
+    PM_LOG_WARN("Stash pool can't hold [%ld], use lv_mem", size);
+    return lv_mem_alloc(size);
+}
+
+static void StashPoolFree(void* ptr)
+{
+    uintptr_t offset = (uintptr_t)ptr - (uintptr_t)StashPool.Block;
+
+    if (offset < sizeof(StashPool.Block))
+    {
+        StashPool.UsedMask &= ~(1UL << (offset / PAGE_STASH_POOL_BLOCK_SIZE));
+    }
+    else
+    {
+        lv_mem_free(ptr);
+    }
+}
+
 void PageBase::SetCustomCacheEnable(bool en)
 {
     PM_LOG_INFO("Page(%s) %s = %d", _Name, __func__, en);
@@ -36,6 +75,13 @@ void PageBase::SetCustomAutoCacheEnable(bool en)
     priv.ReqDisableAutoCache = !en;
 }
 
+void PageBase::SetCustomLoadStepEnable(bool en, bool progressive)
+{
+    PM_LOG_INFO("Page(%s) %s = %d, progressive = %d", _Name, __func__, en, progressive);
+    priv.IsLoadStep = en;
+    priv.IsLoadProgressive = en && progressive;
+}
+
 void PageBase::SetCustomLoadAnimType(
     uint8_t animType,
     uint16_t time,
@@ -67,8 +113,50 @@ bool PageBase::StashPop(void* ptr, uint32_t size)
     }
 
     memcpy(ptr, priv.Stash.ptr, priv.Stash.size);
-    lv_mem_free(priv.Stash.ptr);
-    priv.Stash.ptr = nullptr;
+    StashRelease();
+    return true;
+}
+
+bool PageBase::StashSave(const Stash_t* stash)
+{
+    /* A stash of another size can't be overwritten in place */
+    if (priv.Stash.ptr != nullptr && priv.Stash.size != stash->size)
+    {
+        StashRelease();
+    }
+
+    void* buffer = priv.Stash.ptr;
+
+    if (buffer == nullptr)
+    {
+        buffer = (stash->size <= sizeof(priv.StashInline)) ? priv.StashInline : StashPoolAlloc(stash->size);
+        if (buffer == nullptr)
+        {
+            PM_LOG_ERROR("Page(%s) stash malloc[%ld] failed", _Name, stash->size);
+            return false;
+        }
+    }
+
+    memcpy(buffer, stash->ptr, stash->size);
+    PM_LOG_INFO("Page(%s) stash memcpy[%ld] 0x%p >> 0x%p", _Name, stash->size, stash->ptr, buffer);
+    priv.Stash.ptr = buffer;
+    priv.Stash.size = stash->size;
     return true;
 }
 
+void PageBase::StashRelease()
+{
+    if (priv.Stash.ptr == nullptr)
+    {
+        return;
+    }
+
+    if (priv.Stash.ptr != priv.StashInline)
+    {
+        StashPoolFree(priv.Stash.ptr);
+    }
+
+    priv.Stash.ptr = nullptr;
+    priv.Stash.size = 0;
+}
+
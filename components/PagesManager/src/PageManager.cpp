@@ -2,6 +2,21 @@
 #include "PageManagerLog.h"
 #include <algorithm>
 
+#ifdef ESP_PLATFORM
+#include "esp_heap_caps.h"
+#include "esp_timer.h"
+/* Snapshots don't fit the LVGL heap, keep them in PSRAM */
+#define PM_SNAPSHOT_MALLOC(size) heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT)
+#define PM_SNAPSHOT_FREE(ptr)    heap_caps_free(ptr)
+#define PM_TICK_US()             ((uint32_t)esp_timer_get_time())
+#else
+#include <chrono>
+#define PM_SNAPSHOT_MALLOC(size) malloc(size)
+#define PM_SNAPSHOT_FREE(ptr)    free(ptr)
+#define PM_TICK_US()             ((uint32_t)std::chrono::duration_cast<std::chrono::microseconds>( \
+                                     std::chrono::steady_clock::now().time_since_epoch()).count())
+#endif
+
 #define PM_EMPTY_PAGE_NAME "EMPTY_PAGE"
 
 /*************************************
@@ -20,6 +35,14 @@ PageManager::PageManager(PageFactory* factory)
     , _RootDefaultStyle(nullptr)
 {
     memset(&_AnimState, 0, sizeof(_AnimState));
+    memset(&_CacheState, 0, sizeof(_CacheState));
+    memset(&_ScrollState, 0, sizeof(_ScrollState));
+    memset(&_NavQueue, 0, sizeof(_NavQueue));
+    memset(&_Profile, 0, sizeof(_Profile));
+    _CacheState.Budget = PAGE_CACHE_BUDGET_DEFAULT;
+    _Preload.Timer = nullptr;
+    _Preload.Current = nullptr;
+    _LoadStepTimer = nullptr;
 
     SetGlobalLoadAnimType();
 }
@@ -31,7 +54,32 @@ PageManager::PageManager(PageFactory* factory)
   */
 PageManager::~PageManager()
 {
+    if (_Preload.Timer != nullptr)
+    {
+        lv_timer_del(_Preload.Timer);
+    }
+
+    if (_LoadStepTimer != nullptr)
+    {
+        lv_timer_del(_LoadStepTimer);
+    }
+
+    if (_NavQueue.IsDrainPending)
+    {
+        lv_async_call_cancel(onNavQueueDrain, this);
+    }
+
+    for (int i = 0; i < _NavQueue.Count; i++)
+    {
+        NavReqRelease(&_NavQueue.Req[i]);
+    }
+
     SetStackClear();
+
+    for (auto iter : _PageIDMap)
+    {
+        free((void*)iter.first);
+    }
 }
 
 /**
@@ -41,14 +89,42 @@ PageManager::~PageManager()
   */
 PageBase* PageManager::FindPageInPool(const char* name)
 {
-    for (auto iter : _PagePool)
+    auto iter = _PageIDMap.find(name);
+    return (iter == _PageIDMap.end()) ? nullptr : _PageTable[iter->second];
+}
+
+/**
+  * @brief  Get the ID of a page name, allocate one if the name is new
+  * @param  name: Page name
+  * @retval Page ID
+  */
+uint16_t PageManager::NameIntern(const char* name)
+{
+    auto iter = _PageIDMap.find(name);
+
+    if (iter != _PageIDMap.end())
     {
-        if (strcmp(name, iter->_Name) == 0)
-        {
-            return iter;
-        }
+        return iter->second;
     }
-    return nullptr;
+
+    /* The key must outlive the page, which may own its name */
+    uint16_t id = (uint16_t)_PageTable.size();
+    _PageIDMap[strdup(name)] = id;
+    _PageTable.push_back(nullptr);
+    _PageStackIndex.push_back(0);
+
+    return id;
+}
+
+/**
+  * @brief  Get the ID of a page
+  * @param  name: Page name
+  * @retval Page ID, or PAGE_ID_NONE if the name was never registered
+  */
+uint16_t PageManager::GetPageID(const char* name)
+{
+    auto iter = _PageIDMap.find(name);
+    return (iter == _PageIDMap.end()) ? PAGE_ID_NONE : iter->second;
 }
 
 /**
@@ -58,20 +134,14 @@ PageBase* PageManager::FindPageInPool(const char* name)
   */
 PageBase* PageManager::FindPageInStack(const char* name)
 {
-    decltype(_PageStack) stk = _PageStack;
-    while (!stk.empty())
-    {
-        PageBase* base = stk.top();
-
-        if (strcmp(name, base->_Name) == 0)
-        {
-            return base;
-        }
+    PageBase* base = FindPageInPool(name);
 
-        stk.pop();
+    if (base == nullptr || _PageStackIndex[base->_ID] == 0)
+    {
+        return nullptr;
     }
 
-    return nullptr;
+    return base;
 }
 
 /**
@@ -82,21 +152,27 @@ PageBase* PageManager::FindPageInStack(const char* name)
   */
 bool PageManager::Install(const char* className, const char* appName)
 {
-    if (_Factory == nullptr)
-    {
-        PM_LOG_ERROR("Factory was not registered, can't install page");
-        return false;
-    }
-
     if (appName == nullptr)
     {
         PM_LOG_WARN("appName has not set");
         appName = className;
     }
 
-    if (FindPageInPool(appName) != nullptr)
+    /* Registered classes don't need the factory */
+    uint32_t classID = PageRegistry::NameHash(className);
+    if (PageRegistry::Find(classID) != nullptr)
+    {
+        return Install(classID, appName);
+    }
+
+    if (_Factory == nullptr)
+    {
+        PM_LOG_ERROR("Factory was not registered, can't install page");
+        return false;
+    }
+
+    if (!InstallCheck(appName))
     {
-        PM_LOG_ERROR("Page(%s) was registered", appName);
         return false;
     }
 
@@ -107,13 +183,72 @@ bool PageManager::Install(const char* className, const char* appName)
         return false;
     }
 
+    PM_LOG_INFO("Install Page[class = %s, name = %s]", className, appName);
+    return InstallPage(base, nullptr, appName);
+}
+
+/**
+  * @brief  Install a page class registered with PAGE_REGISTER
+  * @param  classID: PageRegistry::NameHash() of the class name
+  * @param  appName: Page application name, no duplicates allowed
+  * @retval Return true if successful
+  */
+bool PageManager::Install(uint32_t classID, const char* appName)
+{
+    const PageRegistry::Entry* entry = PageRegistry::Find(classID);
+    if (entry == nullptr)
+    {
+        PM_LOG_ERROR("Registry has not class(0x%08lx)", classID);
+        return false;
+    }
+
+    if (!InstallCheck(appName))
+    {
+        return false;
+    }
+
+    PM_LOG_INFO("Install Page[class = 0x%08lx, name = %s]", classID, appName);
+    return InstallPage(entry->Create(), entry->Destroy, appName);
+}
+
+/**
+  * @brief  Check whether a page can be installed under the name
+  * @param  appName: Page application name, no duplicates allowed
+  * @retval Return true if the name is free
+  */
+bool PageManager::InstallCheck(const char* appName)
+{
+    if (appName == nullptr)
+    {
+        PM_LOG_ERROR("appName has not set");
+        return false;
+    }
+
+    if (FindPageInPool(appName) != nullptr)
+    {
+        PM_LOG_ERROR("Page(%s) was registered", appName);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Initialize a newly created page and register it
+  * @param  base: Pointer to the created page
+  * @param  destroy: Frees the page when it is uninstalled, nullptr = delete
+  * @param  appName: Page application name, no duplicates allowed
+  * @retval Return true if successful
+  */
+bool PageManager::InstallPage(PageBase* base, PageRegistry::DestroyFunc_t destroy, const char* appName)
+{
     base->_root = nullptr;
     base->_ID = 0;
     base->_Manager = nullptr;
     base->_UserData = nullptr;
     memset(&base->priv, 0, sizeof(base->priv));
+    base->priv.Destroy = destroy;
 
-    PM_LOG_INFO("Install Page[class = %s, name = %s]", className, appName);
     bool retval = Register(base, appName);
 
     base->onCustomAttrConfig();
@@ -143,7 +278,7 @@ bool PageManager::Uninstall(const char* appName)
         return false;
     }
 
-    if (base->priv.IsCached)
+    if (base->priv.IsCached || base->priv.IsLoading)
     {
         PM_LOG_WARN("Page(%s) has cached, unloading...", appName);
         base->priv.State = PageBase::PAGE_STATE_UNLOAD;
@@ -154,7 +289,17 @@ bool PageManager::Uninstall(const char* appName)
         PM_LOG_INFO("Page(%s) has not cache", appName);
     }
 
-    delete base;
+    /* The page is gone before its root */
+    lv_async_call_cancel(onProfileUnloadDone, base);
+
+    if (base->priv.Destroy != nullptr)
+    {
+        base->priv.Destroy(base);
+    }
+    else
+    {
+        delete base;
+    }
     PM_LOG_INFO("Uninstall OK");
     return true;
 }
@@ -174,7 +319,9 @@ bool PageManager::Register(PageBase* base, const char* name)
 
     base->_Manager = this;
     base->_Name = name;
+    base->_ID = NameIntern(name);
 
+    _PageTable[base->_ID] = base;
     _PagePool.push_back(base);
 
     return true;
@@ -213,6 +360,14 @@ bool PageManager::Unregister(const char* name)
     }
 
     _PagePool.erase(iter);
+    _PageTable[base->_ID] = nullptr;
+
+    auto qIter = std::find(_Preload.Queue.begin(), _Preload.Queue.end(), base);
+
+    if (qIter != _Preload.Queue.end())
+    {
+        _Preload.Queue.erase(qIter);
+    }
 
     PM_LOG_INFO("Unregister OK");
     return true;
@@ -225,7 +380,7 @@ bool PageManager::Unregister(const char* name)
   */
 PageBase* PageManager::GetStackTop()
 {
-    return _PageStack.empty() ? nullptr : _PageStack.top();
+    return _PageStack.empty() ? nullptr : _PageStack.back();
 }
 
 /**
@@ -235,20 +390,30 @@ PageBase* PageManager::GetStackTop()
   */
 PageBase* PageManager::GetStackTopAfter()
 {
-    PageBase* top = GetStackTop();
-
-    if (top == nullptr)
-    {
-        return nullptr;
-    }
-
-    _PageStack.pop();
-
-    PageBase* topAfter = GetStackTop();
+    size_t size = _PageStack.size();
+    return (size < 2) ? nullptr : _PageStack[size - 2];
+}
 
-    _PageStack.push(top);
+/**
+  * @brief  Push a page onto the page stack
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::StackPush(PageBase* base)
+{
+    _PageStack.push_back(base);
+    _PageStackIndex[base->_ID] = (uint16_t)_PageStack.size();
+}
 
-    return topAfter;
+/**
+  * @brief  Remove the top page of the page stack
+  * @param  None
+  * @retval None
+  */
+void PageManager::StackPop()
+{
+    _PageStackIndex[_PageStack.back()->_ID] = 0;
+    _PageStack.pop_back();
 }
 
 /**
@@ -286,7 +451,7 @@ void PageManager::SetStackClear(bool keepBottom)
 
         FourceUnload(top);
 
-        _PageStack.pop();
+        StackPop();
     }
     PM_LOG_INFO("Stack clear done");
 }
@@ -550,7 +715,10 @@ void PageManager::onRootDragEvent(lv_event_t* event)
 
         /* Temporary showing the bottom page */
         PageBase* bottomPage = manager->GetStackTopAfter();
-        lv_obj_clear_flag(bottomPage->_root, LV_OBJ_FLAG_HIDDEN);
+        if (bottomPage && bottomPage->_root)
+        {
+            lv_obj_clear_flag(bottomPage->_root, LV_OBJ_FLAG_HIDDEN);
+        }
     }
     else if (eventCode == LV_EVENT_PRESSING)
     {
@@ -634,10 +802,12 @@ void PageManager::onRootDragAnimFinish(lv_anim_t* a)
 
     /* Hide the bottom page */
     PageBase* bottomPage = manager->GetStackTopAfter();
-    if (bottomPage)
+    if (bottomPage && bottomPage->_root)
     {
         lv_obj_add_flag(bottomPage->_root, LV_OBJ_FLAG_HIDDEN);
     }
+
+    manager->NavQueueResume();
 }
 
 /**
@@ -700,6 +870,21 @@ void PageManager::RootGetDragPredict(lv_coord_t* x, lv_coord_t* y)
     *y = y_predict;
 }
 
+/**
+  * @brief  Move the root of the page, and its animation snapshot, to the foreground
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::RootMoveForeground(PageBase* base)
+{
+    lv_obj_move_foreground(base->_root);
+
+    if (base->priv.Anim.Snapshot != nullptr)
+    {
+        lv_obj_move_foreground(base->priv.Anim.Snapshot);
+    }
+}
+
 /**********************************
  * PAGE MANAGER ROUTER
  * *************************************
@@ -712,10 +897,10 @@ void PageManager::RootGetDragPredict(lv_coord_t* x, lv_coord_t* y)
    */
 bool PageManager::Replace(const char* name, const PageBase::Stash_t* stash)
 {
-    /* Check whether the animation of switching pages is being executed */
+    /* Queue the request while the animation of switching pages is being executed */
     if (!SwitchAnimStateCheck())
     {
-        return false;
+        return NavEnqueue(NAV_REPLACE, name, stash);
     }
 
     /* Check whether the stack is repeatedly pushed  */
@@ -750,10 +935,10 @@ bool PageManager::Replace(const char* name, const PageBase::Stash_t* stash)
     base->priv.IsDisableAutoCache = base->priv.ReqDisableAutoCache;
 
     /* Remove current page */
-    _PageStack.pop();
+    StackPop();
 
     /* Push into the stack */
-    _PageStack.push(base);
+    StackPush(base);
 
     PM_LOG_INFO("Page(%s) replace Page(%s) (stash = 0x%p)", name, top->_Name, stash);
 
@@ -769,10 +954,10 @@ bool PageManager::Replace(const char* name, const PageBase::Stash_t* stash)
   */
 bool PageManager::Push(const char* name, const PageBase::Stash_t* stash)
 {
-    /* Check whether the animation of switching pages is being executed */
+    /* Queue the request while the animation of switching pages is being executed */
     if (!SwitchAnimStateCheck())
     {
-        return false;
+        return NavEnqueue(NAV_PUSH, name, stash);
     }
 
     /* Check whether the stack is repeatedly pushed  */
@@ -795,7 +980,7 @@ bool PageManager::Push(const char* name, const PageBase::Stash_t* stash)
     base->priv.IsDisableAutoCache = base->priv.ReqDisableAutoCache;
 
     /* Push into the stack */
-    _PageStack.push(base);
+    StackPush(base);
 
     PM_LOG_INFO("Page(%s) push >> [Screen] (stash = 0x%p)", name, stash);
 
@@ -810,10 +995,10 @@ bool PageManager::Push(const char* name, const PageBase::Stash_t* stash)
   */
 bool PageManager::Pop()
 {
-    /* Check whether the animation of switching pages is being executed */
+    /* Queue the request while the animation of switching pages is being executed */
     if (!SwitchAnimStateCheck())
     {
-        return false;
+        return NavEnqueue(NAV_POP, nullptr, nullptr);
     }
 
     /* Get the top page of the stack */
@@ -835,7 +1020,7 @@ bool PageManager::Pop()
     PM_LOG_INFO("Page(%s) pop << [Screen]", top->_Name);
 
     /* Page popup */
-    _PageStack.pop();
+    StackPop();
 
     /* Get the next page */
     top = GetStackTop();
@@ -872,34 +1057,7 @@ bool PageManager::SwitchTo(PageBase* newNode, bool isEnterAct, const PageBase::S
     if (stash != nullptr)
     {
         PM_LOG_INFO("stash is detect, %s >> stash(0x%p) >> %s", GetPagePrevName(), stash, newNode->_Name);
-
-        void* buffer = nullptr;
-
-        if (newNode->priv.Stash.ptr == nullptr)
-        {
-            buffer = lv_mem_alloc(stash->size);
-            if (buffer == nullptr)
-            {
-                PM_LOG_ERROR("stash malloc failed");
-            }
-            else
-            {
-                PM_LOG_INFO("stash(0x%p) malloc[%ld]", buffer, stash->size);
-            }
-        }
-        else if(newNode->priv.Stash.size == stash->size)
-        {
-            buffer = newNode->priv.Stash.ptr;
-            PM_LOG_INFO("stash(0x%p) is exist", buffer);
-        }
-
-        if (buffer != nullptr)
-        {
-            memcpy(buffer, stash->ptr, stash->size);
-            PM_LOG_INFO("stash memcpy[%ld] 0x%p >> 0x%p", stash->size, stash->ptr, buffer);
-            newNode->priv.Stash.ptr = buffer;
-            newNode->priv.Stash.size = stash->size;
-        }
+        newNode->StashSave(stash);
     }
 
     /* Record current page */
@@ -911,11 +1069,15 @@ bool PageManager::SwitchTo(PageBase* newNode, bool isEnterAct, const PageBase::S
         /* Direct display, no need to load */
         PM_LOG_INFO("Page(%s) has cached, appear driectly", _PageCurrent->_Name);
         _PageCurrent->priv.State = PageBase::PAGE_STATE_WILL_APPEAR;
+        _PageCurrent->priv.Cache.Hit++;
+        _CacheState.Hit++;
     }
     else
     {
         /* Load page */
         _PageCurrent->priv.State = PageBase::PAGE_STATE_LOAD;
+        _PageCurrent->priv.Cache.Miss++;
+        _CacheState.Miss++;
     }
 
     if (_PagePrev != nullptr)
@@ -933,6 +1095,36 @@ bool PageManager::SwitchTo(PageBase* newNode, bool isEnterAct, const PageBase::S
         SwitchAnimTypeUpdate(_PageCurrent);
     }
 
+    /* A view built in steps is finished before the previous page leaves */
+    if (_PageCurrent->priv.State == PageBase::PAGE_STATE_LOAD
+            && _PageCurrent->priv.IsLoadStep
+            && !_PageCurrent->priv.IsLoadProgressive)
+    {
+        _PageCurrent->priv.State = StateLoadExecute(_PageCurrent);
+
+        if (_PageCurrent->priv.State == PageBase::PAGE_STATE_LOAD)
+        {
+            /* Continued by the load step timer */
+            return true;
+        }
+    }
+
+    SwitchExecute();
+    return true;
+}
+
+/**
+  * @brief  Update the state machines of the switching pages and their layers
+  * @param  None
+  * @retval None
+  */
+void PageManager::SwitchExecute()
+{
+    ProfileSwitchBegin();
+
+    /* The panel shifts the pixels, LVGL only draws the exposed strips */
+    ScrollBegin();
+
     /* Update the state machine of the previous page */
     StateUpdate(_PagePrev);
 
@@ -943,16 +1135,15 @@ bool PageManager::SwitchTo(PageBase* newNode, bool isEnterAct, const PageBase::S
     if (_AnimState.IsEntering)
     {
         PM_LOG_INFO("Page ENTER is detect, move Page(%s) to foreground", _PageCurrent->_Name);
-        if (_PagePrev)lv_obj_move_foreground(_PagePrev->_root);
-        lv_obj_move_foreground(_PageCurrent->_root);
+        if (_PagePrev)RootMoveForeground(_PagePrev);
+        RootMoveForeground(_PageCurrent);
     }
     else
     {
         PM_LOG_INFO("Page EXIT is detect, move Page(%s) to foreground", GetPagePrevName());
-        lv_obj_move_foreground(_PageCurrent->_root);
-        if (_PagePrev)lv_obj_move_foreground(_PagePrev->_root);
+        RootMoveForeground(_PageCurrent);
+        if (_PagePrev)RootMoveForeground(_PagePrev);
     }
-    return true;
 }
 
 /**
@@ -973,8 +1164,13 @@ bool PageManager::FourceUnload(PageBase* base)
     if (base->priv.State == PageBase::PAGE_STATE_ACTIVITY)
     {
         PM_LOG_INFO("Page state is ACTIVITY, Disappearing...");
+        uint32_t tick = ProfileTick();
         base->onViewWillDisappear();
+        ProfileRecord(base, PageBase::PAGE_PROFILE_WILL_DISAPPEAR, tick);
+
+        tick = ProfileTick();
         base->onViewDidDisappear();
+        ProfileRecord(base, PageBase::PAGE_PROFILE_DID_DISAPPEAR, tick);
     }
 
     base->priv.State = StateUnloadExecute(base);
@@ -989,10 +1185,10 @@ bool PageManager::FourceUnload(PageBase* base)
   */
 bool PageManager::BackHome()
 {
-    /* Check whether the animation of switching pages is being executed */
+    /* Queue the request while the animation of switching pages is being executed */
     if (!SwitchAnimStateCheck())
     {
-        return false;
+        return NavEnqueue(NAV_BACK_HOME, nullptr, nullptr);
     }
 
     SetStackClear(true);
@@ -1017,14 +1213,19 @@ bool PageManager::SwitchAnimStateCheck()
     {
         PM_LOG_WARN(
             "Page switch busy[AnimState.IsSwitchReq = %d,"
-            "AnimState.IsBusy = %d],"
-            "request ignored",
+            "AnimState.IsBusy = %d]",
             _AnimState.IsSwitchReq,
             _AnimState.IsBusy
         );
         return false;
     }
 
+    /* Keep the order of the requests already queued */
+    if (_NavQueue.Count > 0 && !_NavQueue.IsDraining)
+    {
+        return false;
+    }
+
     return true;
 }
 
@@ -1044,6 +1245,22 @@ bool PageManager::SwitchReqCheck()
         _AnimState.IsSwitchReq = false;
         ret = true;
         _PagePrev = _PageCurrent;
+
+        if (_ScrollState.IsActive)
+        {
+            ScrollEnd();
+        }
+
+        /* The hidden pages are settled, trim the cache */
+        CacheEvict();
+
+        /* Build the pages likely to be shown next */
+        PreloadHintCheck(_PageCurrent);
+
+        ProfileOverlayUpdate();
+
+        /* Continue with the requests made during the switch */
+        NavQueueResume();
     }
     else
     {
@@ -1071,6 +1288,22 @@ void PageManager::onSwitchAnimFinish(lv_anim_t* a)
     PageManager* manager = base->_Manager;
 
     PM_LOG_INFO("Page(%s) Anim finish", base->_Name);
+    manager->ProfileAnimEnd(base);
+
+    if (base->priv.Anim.Snapshot != nullptr || manager->_ScrollState.IsActive)
+    {
+        /* Leave the root where the snapshot or the panel scroll ended */
+        LoadAnimAttr_t animAttr;
+        if (manager->GetCurrentLoadAnimAttr(&animAttr))
+        {
+            animAttr.setter(base->_root, a->end_value);
+        }
+    }
+
+    if (base->priv.Anim.Snapshot != nullptr)
+    {
+        manager->AnimSnapshotRelease(base);
+    }
 
     manager->StateUpdate(base);
     base->priv.Anim.IsBusy = false;
@@ -1109,6 +1342,32 @@ void PageManager::SwitchAnimCreate(PageBase* base)
         start = animAttr.getter(base->_root);
     }
 
+    if (_ScrollState.IsActive)
+    {
+        if (base->priv.Anim.IsEnter)
+        {
+            /* The root stays at its end, the animation drives the panel scroll */
+            const AnimValue_t* value = _AnimState.IsEntering ? &animAttr.push : &animAttr.pop;
+            animAttr.setter(base->_root, value->enter.end);
+            lv_anim_set_var(&a, base);
+            lv_anim_set_exec_cb(&a, onScrollAnimExec);
+        }
+        else
+        {
+            /* Its pixels are already on the panel */
+            lv_obj_add_flag(base->_root, LV_OBJ_FLAG_HIDDEN);
+            lv_anim_set_exec_cb(&a, nullptr);
+        }
+    }
+    /* Every frame becomes an image blit instead of redrawing the widgets */
+    else if (_AnimState.IsSnapshotEnable
+            && animAttr.dragDir != ROOT_DRAG_DIR_NONE
+            && a.time > 0
+            && AnimSnapshotCreate(base))
+    {
+        lv_anim_set_var(&a, base->priv.Anim.Snapshot);
+    }
+
     if (_AnimState.IsEntering)
     {
         if (base->priv.Anim.IsEnter)
@@ -1226,54 +1485,1287 @@ void PageManager::AnimDefaultInit(lv_anim_t* a)
     lv_anim_set_time(a, time);
     lv_anim_set_path_cb(a, _AnimState.Current.Path);
 }
-/**********************************
- * PAGE MANAGER STATE
- * *************************************
- */
+
 /**
-  * @brief  Update page state machine
-  * @param  base: Pointer to the updated page
-  * @retval None
+  * @brief  Render the page once into an image that stands in for the root while animating
+  * @param  base: Pointer to the page
+  * @retval Return true if successful, otherwise the root is animated
   */
-void PageManager::StateUpdate(PageBase* base)
+bool PageManager::AnimSnapshotCreate(PageBase* base)
 {
-    if (base == nullptr)
-        return;
+    lv_obj_t* root = base->_root;
+    uint32_t size = lv_snapshot_buf_size_needed(root, LV_IMG_CF_TRUE_COLOR);
 
-    switch (base->priv.State)
+    /* The snapshot must cover the root exactly to be moved by the root setter */
+    if (size != (uint32_t)lv_obj_get_width(root) * lv_obj_get_height(root) * sizeof(lv_color_t))
     {
-    case PageBase::PAGE_STATE_IDLE:
-        PM_LOG_INFO("Page(%s) state idle", base->_Name);
-        break;
+        PM_LOG_WARN("Page(%s) root has ext draw area, snapshot disabled", base->_Name);
+        return false;
+    }
 
-    case PageBase::PAGE_STATE_LOAD:
-        base->priv.State = StateLoadExecute(base);
-        StateUpdate(base);
-        break;
+    /* Descriptor and pixels in one block */
+    uint8_t* buf = (uint8_t*)PM_SNAPSHOT_MALLOC(sizeof(lv_img_dsc_t) + size);
+    if (buf == nullptr)
+    {
+        PM_LOG_WARN("Page(%s) snapshot malloc[%ld] failed, animate the view", base->_Name, size);
+        return false;
+    }
 
-    case PageBase::PAGE_STATE_WILL_APPEAR:
-        base->priv.State = StateWillAppearExecute(base);
-        break;
+    lv_img_dsc_t* dsc = (lv_img_dsc_t*)buf;
+    if (lv_snapshot_take_to_buf(root, LV_IMG_CF_TRUE_COLOR, dsc, buf + sizeof(lv_img_dsc_t), size) != LV_RES_OK)
+    {
+        PM_LOG_WARN("Page(%s) snapshot failed, animate the view", base->_Name);
+        PM_SNAPSHOT_FREE(buf);
+        return false;
+    }
 
-    case PageBase::PAGE_STATE_DID_APPEAR:
-        base->priv.State = StateDidAppearExecute(base);
-        PM_LOG_INFO("Page(%s) state active", base->_Name);
-        break;
+    lv_obj_t* img = lv_img_create(lv_obj_get_parent(root));
+    lv_img_set_src(img, dsc);
+    lv_obj_set_pos(img, lv_obj_get_x(root), lv_obj_get_y(root));
+    lv_obj_set_user_data(img, buf);
 
-    case PageBase::PAGE_STATE_ACTIVITY:
-        PM_LOG_INFO("Page(%s) state active break", base->_Name);
-        base->priv.State = PageBase::PAGE_STATE_WILL_DISAPPEAR;
-        StateUpdate(base);
-        break;
+    lv_obj_add_flag(root, LV_OBJ_FLAG_HIDDEN);
+    base->priv.Anim.Snapshot = img;
 
-    case PageBase::PAGE_STATE_WILL_DISAPPEAR:
-        base->priv.State = StateWillDisappearExecute(base);
-        break;
+    PM_LOG_INFO("Page(%s) snapshot[%ld] created", base->_Name, size);
+    return true;
+}
 
-    case PageBase::PAGE_STATE_DID_DISAPPEAR:
-        base->priv.State = StateDidDisappearExecute(base);
-        if (base->priv.State == PageBase::PAGE_STATE_UNLOAD)
-        {
+/**
+  * @brief  Delete the animation snapshot of the page and show its root again
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::AnimSnapshotRelease(PageBase* base)
+{
+    lv_obj_t* img = base->priv.Anim.Snapshot;
+    void* buf = lv_obj_get_user_data(img);
+
+    lv_obj_clear_flag(base->_root, LV_OBJ_FLAG_HIDDEN);
+
+    /* The decoder cache is keyed by the descriptor address */
+    lv_img_cache_invalidate_src(buf);
+    lv_obj_del(img);
+    PM_SNAPSHOT_FREE(buf);
+
+    base->priv.Anim.Snapshot = nullptr;
+}
+
+/**********************************
+ * PAGE MANAGER NAVIGATION QUEUE
+ * *************************************
+ */
+/**
+  * @brief  Queue a navigation request made during a page switch,
+  *         merging it with the requests it cancels or supersedes
+  * @param  type: NavType_t of the request
+  * @param  name: The name of the page, nullptr for POP and BACK_HOME
+  * @param  stash: Parameters passed to the page, copied into the queue,
+  *         or into lv_mem if larger than PAGE_STASH_POOL_BLOCK_SIZE
+  * @retval Return true if the request was queued or merged
+  */
+bool PageManager::NavEnqueue(uint8_t type, const char* name, const PageBase::Stash_t* stash)
+{
+    const char* internName = nullptr;
+
+    if (name != nullptr)
+    {
+        /* The caller's string may be gone when the request is executed */
+        auto iter = _PageIDMap.find(name);
+        if (iter == _PageIDMap.end() || _PageTable[iter->second] == nullptr)
+        {
+            PM_LOG_ERROR("Page(%s) was not install", name);
+            return false;
+        }
+        internName = iter->first;
+    }
+
+    NavReq_t* tail = (_NavQueue.Count > 0) ? &_NavQueue.Req[_NavQueue.Count - 1] : nullptr;
+    NavReq_t* req = nullptr;
+
+    switch (type)
+    {
+    case NAV_PUSH:
+        /* The same page pushed again only updates the stash */
+        if (tail != nullptr && tail->Type == NAV_PUSH && tail->Name == internName)
+        {
+            req = tail;
+        }
+        break;
+
+    case NAV_REPLACE:
+        /* Only the last of the pages replacing each other is shown,
+         * a queued push followed by a replace pushes the new page directly
+         */
+        if (tail != nullptr && (tail->Type == NAV_PUSH || tail->Type == NAV_REPLACE))
+        {
+            PM_LOG_INFO("Page(%s) replace Page(%s) in queue", internName, tail->Name);
+            req = tail;
+            type = tail->Type;
+        }
+        break;
+
+    case NAV_POP:
+        /* Popping a replaced page pops the page it replaced */
+        while (tail != nullptr && tail->Type == NAV_REPLACE)
+        {
+            NavReqRelease(tail);
+            _NavQueue.Count--;
+            tail = (_NavQueue.Count > 0) ? tail - 1 : nullptr;
+        }
+
+        /* A page pushed and popped again is never shown */
+        if (tail != nullptr && tail->Type == NAV_PUSH)
+        {
+            PM_LOG_INFO("Page(%s) push and pop cancelled in queue", tail->Name);
+            NavReqRelease(tail);
+            _NavQueue.Count--;
+            return true;
+        }
+        break;
+
+    case NAV_BACK_HOME:
+        /* Pushed pages don't change the home page */
+        while (tail != nullptr && (tail->Type == NAV_PUSH || tail->Type == NAV_BACK_HOME))
+        {
+            NavReqRelease(tail);
+            _NavQueue.Count--;
+            tail = (_NavQueue.Count > 0) ? tail - 1 : nullptr;
+        }
+        break;
+
+    default:
+        return false;
+    }
+
+    if (req == nullptr && _NavQueue.Count >= PAGE_NAV_QUEUE_SIZE)
+    {
+        PM_LOG_WARN("Navigation queue is full, request ignored");
+        return false;
+    }
+
+    /* A larger stash is copied before the queue is changed, a failed copy drops only this request */
+    void* stashHeap = nullptr;
+    if (stash != nullptr && stash->size > sizeof(_NavQueue.Req[0].Stash))
+    {
+        stashHeap = lv_mem_alloc(stash->size);
+        if (stashHeap == nullptr)
+        {
+            PM_LOG_ERROR("stash malloc[%ld] failed, request ignored", stash->size);
+            return false;
+        }
+    }
+
+    if (req == nullptr)
+    {
+        req = &_NavQueue.Req[_NavQueue.Count++];
+    }
+    else
+    {
+        NavReqRelease(req);
+    }
+
+    req->Type = type;
+    req->Name = internName;
+    req->HasStash = (stash != nullptr);
+    req->StashSize = 0;
+    req->StashHeap = stashHeap;
+
+    if (stash != nullptr)
+    {
+        memcpy(stashHeap ? stashHeap : req->Stash, stash->ptr, stash->size);
+        req->StashSize = stash->size;
+    }
+
+    PM_LOG_INFO(
+        "Navigation request(%d, %s) queued, count = %d",
+        type,
+        internName ? internName : "",
+        _NavQueue.Count
+    );
+
+    if (_NavQueue.IsFastForward)
+    {
+        SwitchFastForward();
+    }
+
+    NavQueueResume();
+    return true;
+}
+
+/**
+  * @brief  Schedule the execution of the queued requests if no switch is running
+  * @param  None
+  * @retval None
+  */
+void PageManager::NavQueueResume()
+{
+    if (_NavQueue.Count == 0 || _NavQueue.IsDrainPending)
+    {
+        return;
+    }
+
+    if (_AnimState.IsSwitchReq || _AnimState.IsBusy)
+    {
+        return;
+    }
+
+    /* Not from inside the animation callback that finished the switch */
+    _NavQueue.IsDrainPending = true;
+    lv_async_call(onNavQueueDrain, this);
+}
+
+/**
+  * @brief  Navigation queue drain callback
+  * @param  manager: Pointer to the page manager
+  * @retval None
+  */
+void PageManager::onNavQueueDrain(void* manager)
+{
+    PageManager* self = (PageManager*)manager;
+    self->_NavQueue.IsDrainPending = false;
+    self->NavQueueDrain();
+}
+
+/**
+  * @brief  Execute the queued requests until one of them starts a page switch
+  * @param  None
+  * @retval None
+  */
+void PageManager::NavQueueDrain()
+{
+    while (_NavQueue.Count > 0 && !_AnimState.IsSwitchReq && !_AnimState.IsBusy)
+    {
+        NavReq_t req = _NavQueue.Req[0];
+
+        _NavQueue.Count--;
+        memmove(&_NavQueue.Req[0], &_NavQueue.Req[1], _NavQueue.Count * sizeof(NavReq_t));
+
+        _NavQueue.IsDraining = true;
+        NavExecute(&req);
+        _NavQueue.IsDraining = false;
+
+        /* The page has made its own copy of the stash */
+        NavReqRelease(&req);
+    }
+}
+
+/**
+  * @brief  Execute a queued navigation request
+  * @param  req: Pointer to the request
+  * @retval Return true if successful
+  */
+bool PageManager::NavExecute(const NavReq_t* req)
+{
+    PageBase::Stash_t stash;
+    stash.ptr = req->StashHeap ? req->StashHeap : (void*)req->Stash;
+    stash.size = req->StashSize;
+
+    const PageBase::Stash_t* stashPtr = req->HasStash ? &stash : nullptr;
+
+    switch (req->Type)
+    {
+    case NAV_PUSH:
+        return Push(req->Name, stashPtr);
+    case NAV_POP:
+        return Pop();
+    case NAV_REPLACE:
+        return Replace(req->Name, stashPtr);
+    case NAV_BACK_HOME:
+        return BackHome();
+    default:
+        return false;
+    }
+}
+
+/**
+  * @brief  Free the lv_mem stash copy of a navigation request
+  * @param  req: Pointer to the request
+  * @retval None
+  */
+void PageManager::NavReqRelease(NavReq_t* req)
+{
+    if (req->StashHeap != nullptr)
+    {
+        lv_mem_free(req->StashHeap);
+        req->StashHeap = nullptr;
+    }
+}
+
+/**
+  * @brief  Make the running switch animations end on the next animation tick
+  * @param  None
+  * @retval None
+  */
+void PageManager::SwitchFastForward()
+{
+    PageBase* pages[] = { _PageCurrent, _PagePrev };
+
+    for (PageBase* base : pages)
+    {
+        if (base == nullptr || base->_root == nullptr)
+        {
+            continue;
+        }
+
+        /* The animation drives the root, its snapshot or the panel scroll */
+        void* vars[] = { base->_root, base->priv.Anim.Snapshot, base };
+
+        for (void* var : vars)
+        {
+            lv_anim_t* a = (var != nullptr) ? lv_anim_get(var, nullptr) : nullptr;
+
+            if (a != nullptr
+                    && (a->ready_cb == onSwitchAnimFinish || a->ready_cb == onRootDragAnimFinish))
+            {
+                PM_LOG_INFO("Page(%s) anim fast forward", base->_Name);
+                a->act_time = a->time;
+            }
+        }
+    }
+}
+
+/**********************************
+ * PAGE MANAGER FOCUS
+ * *************************************
+ */
+/**
+  * @brief  Make the focus group of the page the default group while its view is built,
+  *         so the focusable widgets add themselves when they are created
+  * @param  base: Pointer to the page
+  * @retval The previous default group
+  */
+lv_group_t* PageManager::FocusGroupBegin(PageBase* base)
+{
+    lv_group_t* prev = lv_group_get_default();
+
+    if (!_AnimState.IsFocusGroupEnable)
+    {
+        return prev;
+    }
+
+    if (base->priv.Group == nullptr)
+    {
+        base->priv.Group = lv_group_create();
+    }
+
+    lv_group_set_default(base->priv.Group);
+    return prev;
+}
+
+/**
+  * @brief  Restore the default group after building a view
+  * @param  prev: The group returned by FocusGroupBegin
+  * @retval None
+  */
+void PageManager::FocusGroupEnd(lv_group_t* prev)
+{
+    if (_AnimState.IsFocusGroupEnable)
+    {
+        lv_group_set_default(prev);
+    }
+}
+
+/**
+  * @brief  Direct the keypad and encoder input to the focus group of the page
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::FocusGroupSwap(PageBase* base)
+{
+    if (!_AnimState.IsFocusGroupEnable || base->priv.Group == nullptr)
+    {
+        return;
+    }
+
+    lv_group_set_default(base->priv.Group);
+
+    lv_indev_t* indev = lv_indev_get_next(nullptr);
+    while (indev != nullptr)
+    {
+        lv_indev_type_t type = lv_indev_get_type(indev);
+        if (type == LV_INDEV_TYPE_KEYPAD || type == LV_INDEV_TYPE_ENCODER)
+        {
+            lv_indev_set_group(indev, base->priv.Group);
+        }
+        indev = lv_indev_get_next(indev);
+    }
+}
+
+/**
+  * @brief  Delete the focus group of the page with its view
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::FocusGroupDelete(PageBase* base)
+{
+    if (base->priv.Group != nullptr)
+    {
+        lv_group_del(base->priv.Group);
+        base->priv.Group = nullptr;
+    }
+}
+
+/**********************************
+ * PAGE MANAGER SCROLL
+ * *************************************
+ */
+/**
+  * @brief  Start scrolling the panel if the switch is a MOVE along the backend axis
+  * @param  None
+  * @retval Return true if the switch scrolls the panel
+  */
+bool PageManager::ScrollBegin()
+{
+    const ScrollBackend_t* backend = _ScrollState.Backend;
+    LoadAnimAttr_t animAttr;
+
+    if (backend == nullptr
+            || _PagePrev == nullptr
+            || _PagePrev == _PageCurrent
+            || _AnimState.Current.Time == 0
+            || !GetIsMoveAnim(GetCurrentLoadAnimType())
+            || !GetCurrentLoadAnimAttr(&animAttr)
+            || animAttr.dragDir != backend->dir)
+    {
+        return false;
+    }
+
+    lv_disp_t* disp = lv_disp_get_default();
+
+    /* Flush what is pending, it would land on the scrolled panel */
+    lv_refr_now(disp);
+
+    /* From now on only ScrollUpdate may invalidate */
+    lv_disp_enable_invalidation(disp, false);
+    backend->begin();
+
+    int32_t size = (backend->dir == ROOT_DRAG_DIR_HOR) ? LV_HOR_RES : LV_VER_RES;
+    const AnimValue_t* value = _AnimState.IsEntering ? &animAttr.push : &animAttr.pop;
+    _ScrollState.Start = value->enter.start;
+    _ScrollState.DrawStart = _ScrollState.DrawEnd = (value->enter.start > 0) ? 0 : size;
+    _ScrollState.IsActive = true;
+
+    PM_LOG_INFO("Panel scroll begin, start = %ld", _ScrollState.Start);
+    return true;
+}
+
+/**
+  * @brief  Restore the panel and redraw what changed while scrolling
+  * @param  None
+  * @retval None
+  */
+void PageManager::ScrollEnd()
+{
+    lv_disp_t* disp = lv_disp_get_default();
+
+    _ScrollState.Backend->end();
+    lv_disp_enable_invalidation(disp, true);
+    lv_obj_invalidate(lv_disp_get_scr_act(disp));
+    _ScrollState.IsActive = false;
+
+    PM_LOG_INFO("Panel scroll end");
+}
+
+/**
+  * @brief  Panel scroll animation execution callback
+  * @param  var: Pointer to the entering page
+  * @param  v: Position of the entering root
+  * @retval None
+  */
+void PageManager::onScrollAnimExec(void* var, int32_t v)
+{
+    PageBase* base = (PageBase*)var;
+    base->_Manager->ScrollUpdate(v);
+}
+
+/**
+  * @brief  Draw the newly exposed strip of the entering page and shift the panel
+  * @param  pos: Position of the entering root
+  * @retval None
+  */
+void PageManager::ScrollUpdate(int32_t pos)
+{
+    const ScrollBackend_t* backend = _ScrollState.Backend;
+    int32_t size = (backend->dir == ROOT_DRAG_DIR_HOR) ? LV_HOR_RES : LV_VER_RES;
+
+    /* The root sits at its end, the panel shows the range [start, end) of it */
+    int32_t start = LV_MAX(0, -pos);
+    int32_t end = LV_MIN(size, size - pos);
+
+    lv_disp_t* disp = lv_disp_get_default();
+    lv_disp_enable_invalidation(disp, true);
+
+    if (start < _ScrollState.DrawStart)
+    {
+        ScrollInvalidate(start, _ScrollState.DrawStart);
+        _ScrollState.DrawStart = start;
+    }
+
+    if (end > _ScrollState.DrawEnd)
+    {
+        ScrollInvalidate(_ScrollState.DrawEnd, end);
+        _ScrollState.DrawEnd = end;
+    }
+
+    lv_disp_enable_invalidation(disp, false);
+
+    /**
+      * Row k of the root is drawn at k and shown at k + pos - Start,
+      * the scroll area is one screen long so this wraps to k + pos
+      */
+    backend->scroll(pos - _ScrollState.Start);
+}
+
+/**
+  * @brief  Invalidate a full width strip of the screen along the scroll axis
+  * @param  start: First coordinate of the strip
+  * @param  end: Coordinate after the strip
+  * @retval None
+  */
+void PageManager::ScrollInvalidate(int32_t start, int32_t end)
+{
+    lv_area_t area;
+    area.x1 = 0;
+    area.y1 = 0;
+    area.x2 = LV_HOR_RES - 1;
+    area.y2 = LV_VER_RES - 1;
+
+    if (_ScrollState.Backend->dir == ROOT_DRAG_DIR_HOR)
+    {
+        area.x1 = start;
+        area.x2 = end - 1;
+    }
+    else
+    {
+        area.y1 = start;
+        area.y2 = end - 1;
+    }
+
+    /* lv_obj_invalidate_area() grows the area, the strip has to be exact */
+    _lv_inv_area(lv_disp_get_default(), &area);
+}
+
+/**********************************
+ * PAGE MANAGER CACHE
+ * *************************************
+ */
+/* Size of an event callback descriptor (lv_event_dsc_t is private to lv_event.c) */
+#define PM_EVENT_DSC_SIZE (sizeof(lv_event_cb_t) + sizeof(void*) + sizeof(lv_event_code_t))
+
+/**
+  * @brief  Set the memory budget of the cached pages
+  * @param  size: Max total size of the cached views, 0 = unlimited [byte]
+  * @retval None
+  */
+void PageManager::SetCacheBudget(uint32_t size)
+{
+    PM_LOG_INFO("Cache budget = %ld", size);
+    _CacheState.Budget = size;
+
+    if (!_AnimState.IsSwitchReq && !_AnimState.IsBusy)
+    {
+        CacheEvict();
+    }
+}
+
+/**
+  * @brief  Get the total size of the cached views
+  * @param  None
+  * @retval Approximate size [byte]
+  */
+uint32_t PageManager::GetCacheMemUsage()
+{
+    uint32_t usage = 0;
+
+    for (auto iter : _PagePool)
+    {
+        if (iter->priv.IsCached && iter->_root != nullptr)
+        {
+            usage += iter->priv.Cache.MemSize;
+        }
+    }
+
+    return usage;
+}
+
+/**
+  * @brief  Get the cache statistics
+  * @param  stat: Pointer to the output statistics
+  * @retval None
+  */
+void PageManager::GetCacheStat(CacheStat_t* stat)
+{
+    stat->Budget = _CacheState.Budget;
+    stat->MemUsage = GetCacheMemUsage();
+    stat->Hit = _CacheState.Hit;
+    stat->Miss = _CacheState.Miss;
+    stat->Evict = _CacheState.Evict;
+}
+
+/**
+  * @brief  Get the cache statistics of a page
+  * @param  name: Page name
+  * @param  info: Pointer to the output statistics
+  * @retval Return true if the page was found
+  */
+bool PageManager::GetPageCacheInfo(const char* name, PageBase::CacheInfo_t* info)
+{
+    PageBase* base = FindPageInPool(name);
+
+    if (base == nullptr)
+    {
+        PM_LOG_ERROR("Page(%s) was not found", name);
+        return false;
+    }
+
+    *info = base->priv.Cache;
+    return true;
+}
+
+/**
+  * @brief  Print the cache statistics of all pages
+  * @param  None
+  * @retval None
+  */
+void PageManager::DumpCacheInfo()
+{
+    CacheStat_t stat;
+    GetCacheStat(&stat);
+
+    PM_LOG_INFO(
+        "Cache usage = %ld/%ld, hit = %ld, miss = %ld, evict = %ld",
+        stat.MemUsage,
+        stat.Budget,
+        stat.Hit,
+        stat.Miss,
+        stat.Evict
+    );
+
+    for (auto iter : _PagePool)
+    {
+        PM_LOG_INFO(
+            "Page(%s) cached = %d, size = %ld, hit = %ld, miss = %ld",
+            iter->_Name,
+            iter->priv.IsCached && iter->_root != nullptr,
+            iter->priv.Cache.MemSize,
+            iter->priv.Cache.Hit,
+            iter->priv.Cache.Miss
+        );
+    }
+}
+
+/**
+  * @brief  Check if a cached page can be unloaded
+  * @param  base: Pointer to the page
+  * @retval Return true if the page is hidden and not needed by the switching or dragging
+  */
+bool PageManager::CacheCanEvict(PageBase* base)
+{
+    /* The page leaving a switch is not in the WILL_APPEAR state */
+    return base->priv.IsCached
+           && base->_root != nullptr
+           && base->priv.State == PageBase::PAGE_STATE_WILL_APPEAR
+           && !base->priv.Anim.IsBusy
+           && base != _PageCurrent
+           && base != GetStackTopAfter()
+           && !CacheIsDragBottom(base);
+}
+
+/**
+  * @brief  Check if the page is shown under a page of the stack when that page is dragged
+  * @param  base: Pointer to the page
+  * @retval Return true if the page directly above it in the stack has the root drag enabled
+  */
+bool PageManager::CacheIsDragBottom(PageBase* base)
+{
+    uint16_t pos = _PageStackIndex[base->_ID];
+
+    if (pos == 0 || pos >= _PageStack.size())
+    {
+        return false;
+    }
+
+    /* The drag of a page deeper in the stack is used again after popping back to it */
+    lv_obj_t* root = _PageStack[pos]->_root;
+    return root != nullptr && lv_obj_get_event_user_data(root, onRootDragEvent) != nullptr;
+}
+
+/**
+  * @brief  Unload the least recently shown pages until the cache fits the budget
+  * @param  reserve: Size to keep free for a view about to be loaded [byte]
+  * @retval None
+  */
+void PageManager::CacheEvict(uint32_t reserve)
+{
+    if (_CacheState.Budget == 0)
+    {
+        return;
+    }
+
+    uint32_t usage = GetCacheMemUsage() + reserve;
+
+    while (usage > _CacheState.Budget)
+    {
+        PageBase* lru = nullptr;
+
+        for (auto iter : _PagePool)
+        {
+            if (CacheCanEvict(iter) && (lru == nullptr || iter->priv.Cache.LastShow < lru->priv.Cache.LastShow))
+            {
+                lru = iter;
+            }
+        }
+
+        if (lru == nullptr)
+        {
+            PM_LOG_WARN("Cache usage(%ld) over budget(%ld), nothing to evict", usage, _CacheState.Budget);
+            break;
+        }
+
+        PM_LOG_INFO("Page(%s) evicted, size = %ld", lru->_Name, lru->priv.Cache.MemSize);
+
+        /* Keep the stash, the page is loaded again when it is shown */
+        PageBase::Stash_t stash = lru->priv.Stash;
+        lru->priv.Stash.ptr = nullptr;
+        lru->priv.Stash.size = 0;
+
+        usage -= lru->priv.Cache.MemSize;
+        FourceUnload(lru);
+
+        lru->priv.Stash = stash;
+        _CacheState.Evict++;
+    }
+}
+
+/**
+  * @brief  Get the used size of the LVGL heap
+  * @param  None
+  * @retval Used size, or 0 if a custom allocator is used [byte]
+  */
+uint32_t PageManager::CacheGetMemUsed()
+{
+#if LV_MEM_CUSTOM == 0
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    return mon.total_size - mon.free_size;
+#else
+    return 0;
+#endif
+}
+
+/**
+  * @brief  Estimate the memory allocated for an object tree
+  * @param  obj: Pointer to the root object
+  * @retval Approximate size, without the widget private buffers (text, etc.) [byte]
+  */
+uint32_t PageManager::CacheGetObjSize(lv_obj_t* obj)
+{
+    uint32_t size = obj->class_p->instance_size;
+    size += obj->style_cnt * sizeof(_lv_obj_style_t);
+
+    if (obj->spec_attr != nullptr)
+    {
+        size += sizeof(_lv_obj_spec_attr_t);
+        size += obj->spec_attr->child_cnt * sizeof(lv_obj_t*);
+        size += obj->spec_attr->event_dsc_cnt * PM_EVENT_DSC_SIZE;
+
+        for (uint32_t i = 0; i < obj->spec_attr->child_cnt; i++)
+        {
+            size += CacheGetObjSize(obj->spec_attr->children[i]);
+        }
+    }
+
+    return size;
+}
+
+/**********************************
+ * PAGE MANAGER PRELOAD
+ * *************************************
+ */
+/**
+  * @brief  Build the view of a page in the background, so that showing it hits the cache
+  * @param  name: Page name
+  * @retval Return true if the page was queued
+  */
+bool PageManager::Preload(const char* name)
+{
+    PageBase* base = FindPageInPool(name);
+
+    if (base == nullptr)
+    {
+        PM_LOG_ERROR("Page(%s) was not install", name);
+        return false;
+    }
+
+    if (base->_root != nullptr)
+    {
+        PM_LOG_INFO("Page(%s) was loaded, preload ignored", name);
+        return false;
+    }
+
+    if (base->priv.ReqDisableAutoCache && !base->priv.ReqEnableCache)
+    {
+        PM_LOG_WARN("Page(%s) has cache disabled, preload ignored", name);
+        return false;
+    }
+
+    if (std::find(_Preload.Queue.begin(), _Preload.Queue.end(), base) != _Preload.Queue.end())
+    {
+        return true;
+    }
+
+    _Preload.Queue.push_back(base);
+    PM_LOG_INFO("Page(%s) preload queued", name);
+
+    if (_Preload.Timer == nullptr)
+    {
+        _Preload.Timer = lv_timer_create(onPreloadTimer, PAGE_PRELOAD_PERIOD, this);
+    }
+    else
+    {
+        lv_timer_resume(_Preload.Timer);
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Add a navigation hint, nextName is preloaded whenever name is shown
+  * @param  name: Page name
+  * @param  nextName: Name of the page likely to be shown next
+  * @retval None
+  */
+void PageManager::SetPreloadHint(const char* name, const char* nextName)
+{
+    /* The names may not be installed yet, interning keeps the IDs stable */
+    PreloadHint_t hint;
+    hint.ID = NameIntern(name);
+    NameIntern(nextName);
+    hint.NextName = _PageIDMap.find(nextName)->first;
+    _Preload.Hints.push_back(hint);
+}
+
+/**
+  * @brief  Queue the pages hinted to follow a page
+  * @param  base: Pointer to the page that is shown
+  * @retval None
+  */
+void PageManager::PreloadHintCheck(PageBase* base)
+{
+    for (auto iter : _Preload.Hints)
+    {
+        if (iter.ID == base->_ID)
+        {
+            Preload(iter.NextName);
+        }
+    }
+}
+
+/**
+  * @brief  Preload timer callback, builds one queued view when no switch is running
+  * @param  timer: Pointer to the timer
+  * @retval None
+  */
+void PageManager::onPreloadTimer(lv_timer_t* timer)
+{
+    PageManager* manager = (PageManager*)timer->user_data;
+
+    if (manager->_AnimState.IsSwitchReq || manager->_AnimState.IsBusy)
+    {
+        return;
+    }
+
+    /* A view is still being built in steps */
+    if (manager->_Preload.Current != nullptr)
+    {
+        return;
+    }
+
+    if (manager->_Preload.Queue.empty())
+    {
+        lv_timer_pause(timer);
+        return;
+    }
+
+    PageBase* base = manager->_Preload.Queue.front();
+    manager->_Preload.Queue.erase(manager->_Preload.Queue.begin());
+    manager->PreloadExecute(base);
+}
+
+/**
+  * @brief  Build the view of a page hidden and mark it cached
+  * @param  base: Pointer to the page
+  * @retval Return true if the view was built
+  */
+bool PageManager::PreloadExecute(PageBase* base)
+{
+    if (!base->priv.IsLoading)
+    {
+        if (base->_root != nullptr || base->priv.State != PageBase::PAGE_STATE_IDLE)
+        {
+            PM_LOG_INFO("Page(%s) was loaded, preload skipped", base->_Name);
+            return false;
+        }
+
+        /* Don't evict for a page that may never be shown */
+        uint32_t budget = _CacheState.Budget;
+        if (budget != 0 && GetCacheMemUsage() + base->priv.Cache.MemSize > budget)
+        {
+            PM_LOG_WARN("Page(%s) preload skipped, cache budget full", base->_Name);
+            return false;
+        }
+
+        PM_LOG_INFO("Page(%s) preloading...", base->_Name);
+
+        base->priv.IsDisableAutoCache = base->priv.ReqDisableAutoCache;
+        ViewLoadBegin(base);
+        lv_obj_add_flag(base->_root, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    if (!ViewLoadStep(base, lv_tick_get()))
+    {
+        /* Continued by the load step timer */
+        _Preload.Current = base;
+        LoadStepTimerResume();
+        return false;
+    }
+
+    _Preload.Current = nullptr;
+    ViewLoadEnd(base);
+
+    base->priv.IsCached = true;
+    base->priv.IsPreloaded = true;
+    base->priv.State = PageBase::PAGE_STATE_WILL_APPEAR;
+
+    /* Count as recently shown, so the LRU does not drop it right away */
+    base->priv.Cache.LastShow = ++_CacheState.ShowSeq;
+
+    return true;
+}
+
+/**********************************
+ * PAGE MANAGER PROFILER
+ * *************************************
+ */
+PageManager::ProfileMonitor_t PageManager::_ProfileMonitor;
+
+/**
+  * @brief  Get the profiler time base
+  * @param  None
+  * @retval Microseconds, 0 if the profiler is disabled
+  */
+uint32_t PageManager::ProfileTick()
+{
+#if PAGE_PROFILER_ENABLE
+    return PM_TICK_US();
+#else
+    return 0;
+#endif
+}
+
+/**
+  * @brief  Record the duration of a lifecycle callback
+  * @param  base: Pointer to the page
+  * @param  call: Lifecycle callback
+  * @param  tickStart: ProfileTick() before the callback
+  * @param  isEnd: false if more parts of the call follow, e.g. load steps
+  * @retval None
+  */
+void PageManager::ProfileRecord(PageBase* base, PageBase::ProfileCall_t call, uint32_t tickStart, bool isEnd)
+{
+#if PAGE_PROFILER_ENABLE
+    PageBase::ProfileTime_t* time = &base->priv.Profile.Call[call];
+    time->Pending += ProfileTick() - tickStart;
+
+    if (!isEnd)
+    {
+        return;
+    }
+
+    time->Count++;
+    time->Last = time->Pending;
+    time->Max = std::max(time->Max, time->Pending);
+    time->Total += time->Pending;
+    time->Pending = 0;
+#endif
+}
+
+/**
+  * @brief  Start the memory and residency accounting of a view being loaded
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::ProfileLoadBegin(PageBase* base)
+{
+#if PAGE_PROFILER_ENABLE
+    base->priv.Profile.MemUsed = CacheGetMemUsed();
+    base->priv.Profile.LoadTick = lv_tick_get();
+#endif
+}
+
+/**
+  * @brief  Account a view being unloaded, its memory is checked once the root is deleted
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::ProfileUnload(PageBase* base)
+{
+#if PAGE_PROFILER_ENABLE
+    base->priv.Profile.Resident += lv_tick_elaps(base->priv.Profile.LoadTick);
+
+    /* lv_timer runs the newest timer first, this runs after lv_obj_del_async() of the root */
+    lv_async_call(onProfileUnloadDone, base);
+#endif
+}
+
+/**
+  * @brief  Root deletion finished callback
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::onProfileUnloadDone(void* base)
+{
+    PageBase::ProfileInfo_t* profile = &((PageBase*)base)->priv.Profile;
+    profile->MemDelta = (int32_t)(CacheGetMemUsed() - profile->MemUsed);
+}
+
+/**
+  * @brief  Display monitor callback, counts the rendered frames
+  * @param  disp_drv: Pointer to the display driver
+  * @param  time: Render time of the frame [ms]
+  * @param  px: Rendered pixels
+  * @retval None
+  */
+void PageManager::onProfileMonitor(lv_disp_drv_t* disp_drv, uint32_t time, uint32_t px)
+{
+    _ProfileMonitor.FrameCnt++;
+    _ProfileMonitor.FrameTimeMax = std::max(_ProfileMonitor.FrameTimeMax, time);
+
+    if (_ProfileMonitor.Prev)
+    {
+        _ProfileMonitor.Prev(disp_drv, time, px);
+    }
+}
+
+/**
+  * @brief  Start measuring the switch animation
+  * @param  None
+  * @retval None
+  */
+void PageManager::ProfileSwitchBegin()
+{
+#if PAGE_PROFILER_ENABLE
+    lv_disp_t* disp = lv_disp_get_default();
+
+    /* Chain the monitor callback of the display driver */
+    if (!_ProfileMonitor.IsHooked && disp != nullptr)
+    {
+        _ProfileMonitor.Prev = disp->driver->monitor_cb;
+        disp->driver->monitor_cb = onProfileMonitor;
+        _ProfileMonitor.IsHooked = true;
+    }
+
+    _ProfileMonitor.FrameTimeMax = 0;
+    _Profile.FrameStart = _ProfileMonitor.FrameCnt;
+    _Profile.TickStart = lv_tick_get();
+#endif
+}
+
+/**
+  * @brief  Record the switch animation of a page
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::ProfileAnimEnd(PageBase* base)
+{
+#if PAGE_PROFILER_ENABLE
+    base->priv.Profile.AnimTime = lv_tick_elaps(_Profile.TickStart);
+    base->priv.Profile.AnimFrames = _ProfileMonitor.FrameCnt - _Profile.FrameStart;
+    base->priv.Profile.AnimFrameMax = _ProfileMonitor.FrameTimeMax;
+#endif
+}
+
+/**
+  * @brief  Show the statistics of the last switch on the overlay
+  * @param  None
+  * @retval None
+  */
+void PageManager::ProfileOverlayUpdate()
+{
+    if (_Profile.Overlay == nullptr || _PageCurrent == nullptr)
+    {
+        return;
+    }
+
+    const PageBase::ProfileInfo_t* profile = &_PageCurrent->priv.Profile;
+    uint32_t load = profile->Call[PageBase::PAGE_PROFILE_LOAD].Last;
+    uint32_t appear = profile->Call[PageBase::PAGE_PROFILE_WILL_APPEAR].Last
+                      + profile->Call[PageBase::PAGE_PROFILE_DID_APPEAR].Last;
+
+    lv_label_set_text_fmt(
+        _Profile.Overlay,
+        "%s load %ld.%ldms appear %ld.%ldms\n"
+        "anim %ldms %ldf max %ldms mem %ld",
+        _PageCurrent->_Name,
+        load / 1000, load / 100 % 10,
+        appear / 1000, appear / 100 % 10,
+        profile->AnimTime,
+        profile->AnimFrames,
+        profile->AnimFrameMax,
+        profile->MemLoad
+    );
+    lv_obj_move_foreground(_Profile.Overlay);
+}
+
+/**
+  * @brief  Get the profiler statistics of a page
+  * @param  name: Page name
+  * @param  info: Pointer to the output statistics
+  * @retval Return true if the page was found
+  */
+bool PageManager::GetPageProfile(const char* name, PageBase::ProfileInfo_t* info)
+{
+    PageBase* base = FindPageInPool(name);
+
+    if (base == nullptr)
+    {
+        PM_LOG_ERROR("Page(%s) was not found", name);
+        return false;
+    }
+
+    *info = base->priv.Profile;
+
+    /* Count the time of the view still in memory */
+    if (base->_root != nullptr)
+    {
+        info->Resident += lv_tick_elaps(info->LoadTick);
+    }
+    return true;
+}
+
+/**
+  * @brief  Print the profiler statistics of all pages, callback times are the max [us]
+  * @param  None
+  * @retval None
+  */
+void PageManager::DumpProfile()
+{
+    PM_LOG_INFO(
+        "%-12s %7s %7s %7s %7s %7s %7s %5s %4s %4s %6s %6s %8s",
+        "page", "load", "willApr", "didApr", "willDis", "didDis", "unload",
+        "anim", "frm", "fmax", "mem", "delta", "resident"
+    );
+
+    for (auto iter : _PagePool)
+    {
+        PageBase::ProfileInfo_t info;
+        GetPageProfile(iter->_Name, &info);
+
+        PM_LOG_INFO(
+            "%-12s %7ld %7ld %7ld %7ld %7ld %7ld %5ld %4ld %4ld %6ld %6ld %8ld",
+            iter->_Name,
+            info.Call[PageBase::PAGE_PROFILE_LOAD].Max,
+            info.Call[PageBase::PAGE_PROFILE_WILL_APPEAR].Max,
+            info.Call[PageBase::PAGE_PROFILE_DID_APPEAR].Max,
+            info.Call[PageBase::PAGE_PROFILE_WILL_DISAPPEAR].Max,
+            info.Call[PageBase::PAGE_PROFILE_DID_DISAPPEAR].Max,
+            info.Call[PageBase::PAGE_PROFILE_UNLOAD].Max,
+            info.AnimTime,
+            info.AnimFrames,
+            info.AnimFrameMax,
+            info.MemLoad,
+            info.MemDelta,
+            info.Resident
+        );
+    }
+}
+
+/**
+  * @brief  Show the statistics of the last switch on top of the screen
+  * @param  en: Enable the overlay
+  * @retval None
+  */
+void PageManager::SetProfileOverlayEnable(bool en)
+{
+    if (!en)
+    {
+        if (_Profile.Overlay != nullptr)
+        {
+            lv_obj_del(_Profile.Overlay);
+            _Profile.Overlay = nullptr;
+        }
+        return;
+    }
+
+    if (_Profile.Overlay != nullptr)
+    {
+        return;
+    }
+
+    lv_obj_t* label = lv_label_create(lv_layer_sys());
+    lv_obj_set_style_bg_opa(label, LV_OPA_60, 0);
+    lv_obj_set_style_bg_color(label, lv_color_black(), 0);
+    lv_obj_set_style_text_color(label, lv_color_white(), 0);
+    lv_obj_set_style_pad_all(label, 2, 0);
+    lv_obj_align(label, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    lv_label_set_text(label, "");
+    _Profile.Overlay = label;
+
+    ProfileOverlayUpdate();
+}
+
+/**********************************
+ * PAGE MANAGER STATE
+ * *************************************
+ */
+/**
+  * @brief  Update page state machine
+  * @param  base: Pointer to the updated page
+  * @retval None
+  */
+void PageManager::StateUpdate(PageBase* base)
+{
+    if (base == nullptr)
+        return;
+
+    switch (base->priv.State)
+    {
+    case PageBase::PAGE_STATE_IDLE:
+        PM_LOG_INFO("Page(%s) state idle", base->_Name);
+        break;
+
+    case PageBase::PAGE_STATE_LOAD:
+        base->priv.State = StateLoadExecute(base);
+        if (base->priv.State != PageBase::PAGE_STATE_LOAD)
+        {
+            StateUpdate(base);
+        }
+        break;
+
+    case PageBase::PAGE_STATE_WILL_APPEAR:
+        base->priv.State = StateWillAppearExecute(base);
+        break;
+
+    case PageBase::PAGE_STATE_DID_APPEAR:
+        base->priv.State = StateDidAppearExecute(base);
+        PM_LOG_INFO("Page(%s) state active", base->_Name);
+        break;
+
+    case PageBase::PAGE_STATE_ACTIVITY:
+        PM_LOG_INFO("Page(%s) state active break", base->_Name);
+        base->priv.State = PageBase::PAGE_STATE_WILL_DISAPPEAR;
+        StateUpdate(base);
+        break;
+
+    case PageBase::PAGE_STATE_WILL_DISAPPEAR:
+        base->priv.State = StateWillDisappearExecute(base);
+        break;
+
+    case PageBase::PAGE_STATE_DID_DISAPPEAR:
+        base->priv.State = StateDidDisappearExecute(base);
+        if (base->priv.State == PageBase::PAGE_STATE_UNLOAD)
+        {
             StateUpdate(base);
         }
         break;
@@ -1297,13 +2789,71 @@ PageBase::State_t PageManager::StateLoadExecute(PageBase* base)
 {
     PM_LOG_INFO("Page(%s) state load", base->_Name);
 
-    if (base->_root != nullptr)
+    if (base->priv.IsLoading)
+    {
+        /* Resume a view that was started by the preload */
+        if (_Preload.Current == base)
+        {
+            _Preload.Current = nullptr;
+        }
+    }
+    else
+    {
+        if (base->_root != nullptr)
+        {
+            PM_LOG_ERROR("Page(%s) root must be nullptr", base->_Name);
+        }
+
+        /* Make room for the new view, its size is known if it was loaded before */
+        CacheEvict(base->priv.Cache.MemSize);
+
+        ViewLoadBegin(base);
+    }
+
+    if (ViewLoadStep(base, lv_tick_get()))
+    {
+        ViewLoadEnd(base);
+    }
+    else
+    {
+        LoadStepTimerResume();
+
+        if (!base->priv.IsLoadProgressive)
+        {
+            PM_LOG_INFO("Page(%s) loading in steps...", base->_Name);
+            return PageBase::PAGE_STATE_LOAD;
+        }
+
+        PM_LOG_INFO("Page(%s) shown before the load steps finished", base->_Name);
+    }
+
+    ViewDragUpdate(base);
+
+    if (base->priv.IsDisableAutoCache)
+    {
+        PM_LOG_INFO("Page(%s) disable auto cache, ReqEnableCache = %d", base->_Name, base->priv.ReqEnableCache);
+        base->priv.IsCached = base->priv.ReqEnableCache;
+    }
+    else
     {
-        PM_LOG_ERROR("Page(%s) root must be nullptr", base->_Name);
+        PM_LOG_INFO("Page(%s) AUTO cached", base->_Name);
+        base->priv.IsCached = true;
     }
 
+    return PageBase::PAGE_STATE_WILL_APPEAR;
+}
+
+/**
+  * @brief  Create the root of the page and start building its view
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::ViewLoadBegin(PageBase* base)
+{
+    uint32_t memUsed = CacheGetMemUsed();
+
     lv_obj_t* root_obj = lv_obj_create(lv_scr_act());
-    
+
     lv_obj_clear_flag(root_obj, LV_OBJ_FLAG_SCROLLABLE);
     lv_obj_set_user_data(root_obj, base);
 
@@ -1313,39 +2863,175 @@ PageBase::State_t PageManager::StateLoadExecute(PageBase* base)
     }
 
     base->_root = root_obj;
+    ProfileLoadBegin(base);
+
+    lv_group_t* group = FocusGroupBegin(base);
+    uint32_t tick = ProfileTick();
     base->onViewLoad();
+    ProfileRecord(base, PageBase::PAGE_PROFILE_LOAD, tick, false);
+    FocusGroupEnd(group);
+
+    /* The footprint is summed over the steps, they may be spread over several frames */
+    base->priv.Cache.MemSize = CacheGetMemUsed() - memUsed;
+    base->priv.IsLoading = base->priv.IsLoadStep;
+
+    /* Keep an unfinished view off the screen until it appears */
+    if (base->priv.IsLoading && !base->priv.IsLoadProgressive)
+    {
+        lv_obj_add_flag(root_obj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+/**
+  * @brief  Run the load steps of the page until the frame budget is used up
+  * @param  base: Pointer to the page
+  * @param  tickStart: Tick at which the frame budget started
+  * @retval Return true if the view is complete
+  */
+bool PageManager::ViewLoadStep(PageBase* base, uint32_t tickStart)
+{
+    if (!base->priv.IsLoading)
+    {
+        return true;
+    }
+
+    uint32_t memUsed = CacheGetMemUsed();
+    lv_group_t* group = FocusGroupBegin(base);
+    uint32_t tick = ProfileTick();
+    bool isDone;
+
+    do
+    {
+        isDone = base->onViewLoadStep();
+    } while (!isDone && lv_tick_elaps(tickStart) < PAGE_LOAD_STEP_BUDGET);
+
+    ProfileRecord(base, PageBase::PAGE_PROFILE_LOAD, tick, false);
+    FocusGroupEnd(group);
+
+    base->priv.Cache.MemSize += CacheGetMemUsed() - memUsed;
+    base->priv.IsLoading = !isDone;
+
+    return isDone;
+}
+
+/**
+  * @brief  Finish building the view of the page
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::ViewLoadEnd(PageBase* base)
+{
+    uint32_t memUsed = CacheGetMemUsed();
+    lv_group_t* group = FocusGroupBegin(base);
+    uint32_t tick = ProfileTick();
+
+    base->onViewDidLoad();
+    ProfileRecord(base, PageBase::PAGE_PROFILE_LOAD, tick);
+    FocusGroupEnd(group);
+
+    /* Record the view footprint, fall back to walking the tree if lv_mem can't tell */
+    base->priv.Cache.MemSize += CacheGetMemUsed() - memUsed;
+    if ((int32_t)base->priv.Cache.MemSize <= 0)
+    {
+        base->priv.Cache.MemSize = CacheGetObjSize(base->_root);
+    }
+    PM_LOG_INFO("Page(%s) view size = %ld", base->_Name, base->priv.Cache.MemSize);
+    base->priv.Profile.MemLoad = (int32_t)(CacheGetMemUsed() - base->priv.Profile.MemUsed);
+}
+
+/**
+  * @brief  Start or resume the load step timer
+  * @param  None
+  * @retval None
+  */
+void PageManager::LoadStepTimerResume()
+{
+    if (_LoadStepTimer == nullptr)
+    {
+        _LoadStepTimer = lv_timer_create(onLoadStepTimer, LV_DISP_DEF_REFR_PERIOD, this);
+    }
+    else
+    {
+        lv_timer_resume(_LoadStepTimer);
+    }
+}
 
-    if (GetIsOverAnim(GetCurrentLoadAnimType()))
+/**
+  * @brief  Load step timer callback, continues the views built in steps once per frame
+  * @param  timer: Pointer to the timer
+  * @retval None
+  */
+void PageManager::onLoadStepTimer(lv_timer_t* timer)
+{
+    PageManager* manager = (PageManager*)timer->user_data;
+    uint32_t tickStart = lv_tick_get();
+    bool isLoading = false;
+
+    for (auto iter : manager->_PagePool)
     {
-        PageBase* bottomPage = GetStackTopAfter();
+        if (!iter->priv.IsLoading)
+        {
+            continue;
+        }
+
+        if (iter->priv.State == PageBase::PAGE_STATE_LOAD)
+        {
+            /* The switch waits for this view */
+            iter->priv.State = manager->StateLoadExecute(iter);
 
-        if (bottomPage != nullptr && bottomPage->priv.IsCached)
+            if (iter->priv.State != PageBase::PAGE_STATE_LOAD)
+            {
+                manager->SwitchExecute();
+            }
+        }
+        else if (iter->priv.State == PageBase::PAGE_STATE_IDLE)
         {
-            LoadAnimAttr_t animAttr;
-            if (GetCurrentLoadAnimAttr(&animAttr))
+            /* Preloading, yield to the page switching */
+            if (!manager->_AnimState.IsSwitchReq && !manager->_AnimState.IsBusy)
             {
-                if (animAttr.dragDir != ROOT_DRAG_DIR_NONE)
-                {
-                    RootEnableDrag(base->_root);
-                }
+                manager->PreloadExecute(iter);
             }
         }
-    }
+        else if (manager->ViewLoadStep(iter, tickStart))
+        {
+            /* Progressive view finished while it is shown */
+            manager->ViewLoadEnd(iter);
+        }
 
-    base->onViewDidLoad();
+        isLoading = isLoading || iter->priv.IsLoading;
+    }
 
-    if (base->priv.IsDisableAutoCache)
+    if (!isLoading)
     {
-        PM_LOG_INFO("Page(%s) disable auto cache, ReqEnableCache = %d", base->_Name, base->priv.ReqEnableCache);
-        base->priv.IsCached = base->priv.ReqEnableCache;
+        lv_timer_pause(timer);
     }
-    else
+}
+
+/**
+  * @brief  Enable the root drag if the current animation and the bottom page allow it
+  * @param  base: Pointer to the page
+  * @retval None
+  */
+void PageManager::ViewDragUpdate(PageBase* base)
+{
+    if (!GetIsOverAnim(GetCurrentLoadAnimType()))
     {
-        PM_LOG_INFO("Page(%s) AUTO cached", base->_Name);
-        base->priv.IsCached = true;
+        return;
     }
 
-    return PageBase::PAGE_STATE_WILL_APPEAR;
+    PageBase* bottomPage = GetStackTopAfter();
+
+    if (bottomPage != nullptr && bottomPage->priv.IsCached)
+    {
+        LoadAnimAttr_t animAttr;
+        if (GetCurrentLoadAnimAttr(&animAttr))
+        {
+            if (animAttr.dragDir != ROOT_DRAG_DIR_NONE)
+            {
+                RootEnableDrag(base->_root);
+            }
+        }
+    }
 }
 
 /**
@@ -1356,7 +3042,20 @@ PageBase::State_t PageManager::StateLoadExecute(PageBase* base)
 PageBase::State_t PageManager::StateWillAppearExecute(PageBase* base)
 {
     PM_LOG_INFO("Page(%s) state will appear", base->_Name);
+    base->priv.Cache.LastShow = ++_CacheState.ShowSeq;
+
+    /* The switching context is known now */
+    if (base->priv.IsPreloaded)
+    {
+        base->priv.IsPreloaded = false;
+        ViewDragUpdate(base);
+    }
+
+    FocusGroupSwap(base);
+
+    uint32_t tick = ProfileTick();
     base->onViewWillAppear();
+    ProfileRecord(base, PageBase::PAGE_PROFILE_WILL_APPEAR, tick);
     lv_obj_clear_flag(base->_root, LV_OBJ_FLAG_HIDDEN);
     SwitchAnimCreate(base);
     return PageBase::PAGE_STATE_DID_APPEAR;
@@ -1370,7 +3069,9 @@ PageBase::State_t PageManager::StateWillAppearExecute(PageBase* base)
 PageBase::State_t PageManager::StateDidAppearExecute(PageBase* base)
 {
     PM_LOG_INFO("Page(%s) state did appear", base->_Name);
+    uint32_t tick = ProfileTick();
     base->onViewDidAppear();
+    ProfileRecord(base, PageBase::PAGE_PROFILE_DID_APPEAR, tick);
     return PageBase::PAGE_STATE_ACTIVITY;
 }
 
@@ -1382,7 +3083,9 @@ PageBase::State_t PageManager::StateDidAppearExecute(PageBase* base)
 PageBase::State_t PageManager::StateWillDisappearExecute(PageBase* base)
 {
     PM_LOG_INFO("Page(%s) state will disappear", base->_Name);
+    uint32_t tick = ProfileTick();
     base->onViewWillDisappear();
+    ProfileRecord(base, PageBase::PAGE_PROFILE_WILL_DISAPPEAR, tick);
     SwitchAnimCreate(base);
     return PageBase::PAGE_STATE_DID_DISAPPEAR;
 }
@@ -1396,7 +3099,9 @@ PageBase::State_t PageManager::StateDidDisappearExecute(PageBase* base)
 {
     PM_LOG_INFO("Page(%s) state did disappear", base->_Name);
     lv_obj_add_flag(base->_root, LV_OBJ_FLAG_HIDDEN);
+    uint32_t tick = ProfileTick();
     base->onViewDidDisappear();
+    ProfileRecord(base, PageBase::PAGE_PROFILE_DID_DISAPPEAR, tick);
     if (base->priv.IsCached)
     {
         PM_LOG_INFO("Page(%s) has cached", base->_Name);
@@ -1422,20 +3127,43 @@ PageBase::State_t PageManager::StateUnloadExecute(PageBase* base)
         goto Exit;
     }
 
-    base->onViewUnload();
-    if (base->priv.Stash.ptr != nullptr && base->priv.Stash.size != 0)
+    {
+        uint32_t tick = ProfileTick();
+        base->onViewUnload();
+        ProfileRecord(base, PageBase::PAGE_PROFILE_UNLOAD, tick, false);
+    }
+
+    if (base->priv.Anim.Snapshot != nullptr)
+    {
+        AnimSnapshotRelease(base);
+    }
+
+    if (base->priv.Stash.ptr != nullptr)
     {
         PM_LOG_INFO("Page(%s) free stash(0x%p)[%ld]", base->_Name, base->priv.Stash.ptr, base->priv.Stash.size);
-        lv_mem_free(base->priv.Stash.ptr);
-        base->priv.Stash.ptr = nullptr;
-        base->priv.Stash.size = 0;
+        base->StashRelease();
     }
 
+    ProfileUnload(base);
+    FocusGroupDelete(base);
+
     /* Delete after the end of the root animation life cycle */
     lv_obj_del_async(base->_root);
     base->_root = nullptr;
     base->priv.IsCached = false;
-    base->onViewDidUnload();
+    base->priv.IsPreloaded = false;
+    base->priv.IsLoading = false;
+
+    if (_Preload.Current == base)
+    {
+        _Preload.Current = nullptr;
+    }
+
+    {
+        uint32_t tick = ProfileTick();
+        base->onViewDidUnload();
+        ProfileRecord(base, PageBase::PAGE_PROFILE_UNLOAD, tick);
+    }
 
 Exit:
     return PageBase::PAGE_STATE_IDLE;
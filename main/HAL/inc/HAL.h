@@ -12,14 +12,30 @@ namespace HAL {
 void HAL_Init(void);
 /*Fs*/
 void FileSystem_Init(void);
+/*Settings*/
+void Settings_Init(void);
+int32_t Settings_GetInt(const char *key, int32_t def = 0);
+bool Settings_SetInt(const char *key, int32_t value);
+bool Settings_GetBlob(const char *key, void *data, size_t size);
+bool Settings_SetBlob(const char *key, const void *data, size_t size);
+void Settings_Commit(void);
 /*Display*/
 void Display_Init(void);
 void Display_SendPixels(uint32_t x, uint32_t y, uint32_t w, uint32_t h,
                         const uint16_t *pixels);
+bool Display_IsScrollHorizontal(void);
+void Display_ScrollBegin(void);
+void Display_ScrollTo(int32_t offset);
+void Display_ScrollCommit(void);
+void Display_ScrollEnd(void);
+void Display_SetSleep(bool en);
 void Backlight_Init(void);
 uint16_t Backlight_GetVal(void);
 void Backlight_SetVal(uint16_t brightness);
 void Backlight_SetGradually(uint16_t target, uint16_t time_ms = 500);
+bool Backlight_QueueGradually(uint16_t target, uint16_t time_ms = 500);
+void Backlight_StopGradually(void);
+bool Backlight_IsGradually(void);
 
 typedef void (*Display_CallbackFunc_t)(void);
 void Display_SetSendFinishCallback(Display_CallbackFunc_t func);
@@ -27,12 +43,18 @@ void Display_SetSendFinishCallback(Display_CallbackFunc_t func);
 /*Button*/
 void Button_Init(void);
 key_action_t Button_GetAction(void);
+bool Button_GetEvent(key_event_t *event);
+typedef void (*Button_CallbackFunc_t)(void);
+void Button_SetEventCallback(Button_CallbackFunc_t func);
 
 /*SD Card*/
 bool SD_Init(void);
 void SD_Update(void);
 float SD_GetCardSizeMB();
 const char *SD_GetCardInfo(void);
+bool SD_GetReady(void);
+uint32_t SD_Lock(void);
+void SD_Unlock(void);
 
 /*Panic处理*/
 void InitPanicHandler(void);
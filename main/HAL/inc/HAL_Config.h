@@ -21,6 +21,9 @@
 #endif
 
 #define SPI_DEFAULT_FREQUENCY SPI_MASTER_FREQ_40M
+
+/* 1: bind ST7789 and SPI DMA bus at compile time (Arduino_TFT_Static) */
+#define CONFIG_SCREEN_STATIC_DISPATCH 0
 /* Battery */
 #define CONFIG_BAT_DET_PIN          PA1
 #define CONFIG_BAT_CHG_DET_PIN      PA11
@@ -61,12 +64,14 @@
 #define CONFIG_DEBUG_SERIAL         Serial
 
 /* SD CARD */
-#define CONFIG_SD_SPI               SPI_2
-#define CONFIG_SD_CD_PIN            PA8
-#define CONFIG_SD_MOSI_PIN          PB15
-#define CONFIG_SD_MISO_PIN          PB14
-#define CONFIG_SD_SCK_PIN           PB13
-#define CONFIG_SD_CS_PIN            PB12
+#define CONFIG_SD_ENABLE            0         // 1: 使用 SD 卡，需按实际硬件修改下面的引脚
+#define CONFIG_SD_SPI               SPI3_HOST // 屏幕使用 SPI2_HOST
+#define CONFIG_SD_CD_PIN            21        // 插卡时为低电平，-1 = 无检测引脚
+#define CONFIG_SD_MOSI_PIN          17
+#define CONFIG_SD_MISO_PIN          18
+#define CONFIG_SD_SCK_PIN           16
+#define CONFIG_SD_CS_PIN            15
+#define CONFIG_SD_MOUNT_POINT       "/sdcard"
 
 /* Show Stack & Heap Info */
 #define CONFIG_SHOW_STACK_INFO      0
@@ -30,6 +30,13 @@ typedef enum {
   KEY_ACTION_TRIPLE_CLICK, // 三击
 } key_action_t;
 
+// 按键事件，时间为 esp_timer 时间 [us]
+typedef struct {
+  key_action_t action;
+  uint32_t time_us; // 按键回调识别出动作的时间
+  uint32_t down_us; // 完成该动作的最后一次按下的时间
+} key_event_t;
+
 namespace HAL
 {
     /* Clock */
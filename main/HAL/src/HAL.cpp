@@ -5,7 +5,9 @@
 void HAL::HAL_Init(void)
 {
     FileSystem_Init();
+    Settings_Init();
     Backlight_Init();
     Button_Init();
     Display_Init();
+    SD_Init();
 }
\ No newline at end of file
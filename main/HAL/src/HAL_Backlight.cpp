@@ -0,0 +1,214 @@
+#include "../inc/HAL.h"
+#include "esp_timer.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#define BACKLIGHT_FREQ        5000 // PWM 频率 [Hz]
+#define BACKLIGHT_RESOLUTION  12   // PWM 分辨率 [bit]
+#define BACKLIGHT_FADE_PERIOD 10   // 渐变步进周期 [ms]
+#define BACKLIGHT_FADE_QUEUE  4    // 可排队的渐变段数
+
+// 感知亮度 0 - BACKLIGHT_LEVEL_MAX，每段 LUT 之间线性插值
+#define BACKLIGHT_LUT_SHIFT 7
+#define BACKLIGHT_LEVEL_MAX (32 << BACKLIGHT_LUT_SHIFT)
+
+// gamma 2.2: duty = 4095 * (i / 32) ^ 2.2，按感知亮度线性渐变时人眼看起来均匀
+static const uint16_t g_gamma_lut[33] = {
+    0,    2,    9,    22,   42,   69,   103,  145,  194,  251,  317,
+    391,  473,  564,  664,  773,  891,  1018, 1155, 1301, 1456, 1621,
+    1796, 1980, 2175, 2379, 2593, 2818, 3053, 3298, 3553, 3819, 4095};
+
+typedef struct {
+  uint16_t target;
+  uint16_t time_ms;
+} Backlight_Fade_t;
+
+// 渐变状态，由 API 调用方和 esp_timer 任务共同访问，用 g_fade_lock 保护
+static struct {
+  Backlight_Fade_t queue[BACKLIGHT_FADE_QUEUE]; // 等待执行的渐变
+  uint8_t head;
+  uint8_t count;
+
+  bool active;           // 正在渐变
+  uint16_t duty;         // 当前占空比
+  uint16_t target;       // 当前渐变的目标占空比
+  uint32_t level_start;  // 当前渐变的起止感知亮度
+  uint32_t level_end;
+  uint32_t time_us;      // 当前渐变时长
+  int64_t start_us;      // 当前渐变开始时间
+} g_fade;
+
+static portMUX_TYPE g_fade_lock = portMUX_INITIALIZER_UNLOCKED;
+static esp_timer_handle_t g_fade_timer = nullptr;
+
+// 串行化 PWM 写入：步进的计算和写入在同一次持有内完成，
+// 之后的 SetVal 写入一定在它之后，不会被旧的步进值覆盖
+static SemaphoreHandle_t g_write_mutex = NULL;
+
+static void backlight_write(uint16_t duty) {
+#ifdef CONFIG_SCREEN_BLK_PIN
+  ledcWrite(CONFIG_SCREEN_BLK_PIN, duty);
+#endif
+}
+
+static uint16_t backlight_level_to_duty(uint32_t level) {
+  if (level >= BACKLIGHT_LEVEL_MAX) {
+    return g_gamma_lut[32];
+  }
+  uint32_t i = level >> BACKLIGHT_LUT_SHIFT;
+  uint32_t frac = level & ((1 << BACKLIGHT_LUT_SHIFT) - 1);
+  return g_gamma_lut[i] +
+         (((g_gamma_lut[i + 1] - g_gamma_lut[i]) * frac) >> BACKLIGHT_LUT_SHIFT);
+}
+
+static uint32_t backlight_duty_to_level(uint16_t duty) {
+  uint32_t i = 0;
+  while (i < 31 && duty >= g_gamma_lut[i + 1]) {
+    i++;
+  }
+  if (duty >= g_gamma_lut[32]) {
+    return BACKLIGHT_LEVEL_MAX;
+  }
+  uint32_t span = g_gamma_lut[i + 1] - g_gamma_lut[i];
+  return (i << BACKLIGHT_LUT_SHIFT) +
+         (((uint32_t)(duty - g_gamma_lut[i]) << BACKLIGHT_LUT_SHIFT) / span);
+}
+
+// 取出下一段渐变，需在锁内调用，返回是否还有渐变
+static bool backlight_fade_next_locked(void) {
+  if (g_fade.count == 0) {
+    g_fade.active = false;
+    return false;
+  }
+
+  Backlight_Fade_t *fade = &g_fade.queue[g_fade.head];
+  g_fade.head = (g_fade.head + 1) % BACKLIGHT_FADE_QUEUE;
+  g_fade.count--;
+
+  g_fade.target = fade->target;
+  g_fade.level_start = backlight_duty_to_level(g_fade.duty);
+  g_fade.level_end = backlight_duty_to_level(fade->target);
+  g_fade.time_us = (uint32_t)fade->time_ms * 1000;
+  g_fade.start_us = esp_timer_get_time();
+  g_fade.active = true;
+  return true;
+}
+
+// esp_timer 任务中每个步进周期调用一次，不依赖 LVGL 任务
+static void backlight_fade_timer_cb(void *arg) {
+  xSemaphoreTake(g_write_mutex, portMAX_DELAY);
+  portENTER_CRITICAL(&g_fade_lock);
+  if (!g_fade.active) {
+    // 已被取消
+    portEXIT_CRITICAL(&g_fade_lock);
+    xSemaphoreGive(g_write_mutex);
+    return;
+  }
+
+  uint32_t elapsed = (uint32_t)(esp_timer_get_time() - g_fade.start_us);
+  if (elapsed >= g_fade.time_us) {
+    g_fade.duty = g_fade.target;
+    backlight_fade_next_locked();
+  } else {
+    int32_t delta = (int32_t)g_fade.level_end - (int32_t)g_fade.level_start;
+    uint32_t level = g_fade.level_start + (int32_t)((int64_t)delta * elapsed / g_fade.time_us);
+    g_fade.duty = backlight_level_to_duty(level);
+  }
+  uint16_t duty = g_fade.duty;
+  bool active = g_fade.active;
+  portEXIT_CRITICAL(&g_fade_lock);
+
+  // 写入前被 StopGradually 取消时，写入的仍是 g_fade.duty，硬件与记录一致
+  backlight_write(duty);
+  xSemaphoreGive(g_write_mutex);
+
+  // 单次定时器逐次重新启动，空闲时没有定时器唤醒
+  if (active) {
+    esp_timer_start_once(g_fade_timer, BACKLIGHT_FADE_PERIOD * 1000);
+  }
+}
+
+// 加入一段渐变，clear 为 true 时先取消正在进行和排队的渐变
+static bool backlight_fade_add(uint16_t target, uint16_t time_ms, bool clear) {
+  bool start = false;
+  bool ret = true;
+
+  portENTER_CRITICAL(&g_fade_lock);
+  if (clear) {
+    g_fade.count = 0;
+    g_fade.active = false;
+  }
+  if (g_fade.count < BACKLIGHT_FADE_QUEUE) {
+    uint8_t tail = (g_fade.head + g_fade.count) % BACKLIGHT_FADE_QUEUE;
+    g_fade.queue[tail].target = target;
+    g_fade.queue[tail].time_ms = time_ms;
+    g_fade.count++;
+  } else {
+    ret = false;
+  }
+  if (!g_fade.active) {
+    start = backlight_fade_next_locked();
+  }
+  portEXIT_CRITICAL(&g_fade_lock);
+
+  if (start && g_fade_timer) {
+    // 定时器仍在运行时会返回 ESP_ERR_INVALID_STATE，它会继续推进新的渐变
+    esp_timer_start_once(g_fade_timer, BACKLIGHT_FADE_PERIOD * 1000);
+  }
+  return ret;
+}
+
+void HAL::Backlight_Init(void) {
+#ifdef CONFIG_SCREEN_BLK_PIN
+  ledcAttach(CONFIG_SCREEN_BLK_PIN, BACKLIGHT_FREQ, BACKLIGHT_RESOLUTION);
+  // 上电时关闭背光
+  ledcWrite(CONFIG_SCREEN_BLK_PIN, 0);
+#endif
+  g_fade.duty = 0;
+  g_write_mutex = xSemaphoreCreateMutex();
+
+  const esp_timer_create_args_t timer_args = {
+      .callback = &backlight_fade_timer_cb,
+      .arg = NULL,
+      .dispatch_method = ESP_TIMER_TASK,
+      .name = "backlight_fade",
+      .skip_unhandled_events = true};
+  ESP_ERROR_CHECK(esp_timer_create(&timer_args, &g_fade_timer));
+}
+
+void HAL::Backlight_SetVal(uint16_t brightness) {
+  // 正在写入的步进完成后再取消渐变并写入
+  xSemaphoreTake(g_write_mutex, portMAX_DELAY);
+  portENTER_CRITICAL(&g_fade_lock);
+  g_fade.count = 0;
+  g_fade.active = false;
+  g_fade.duty = brightness;
+  portEXIT_CRITICAL(&g_fade_lock);
+
+  backlight_write(brightness);
+  xSemaphoreGive(g_write_mutex);
+}
+
+uint16_t HAL::Backlight_GetVal(void) {
+  return g_fade.duty;
+}
+
+void HAL::Backlight_SetGradually(uint16_t target, uint16_t time_ms) {
+  backlight_fade_add(target, time_ms, true);
+}
+
+bool HAL::Backlight_QueueGradually(uint16_t target, uint16_t time_ms) {
+  return backlight_fade_add(target, time_ms, false);
+}
+
+void HAL::Backlight_StopGradually(void) {
+  // 停在当前亮度
+  portENTER_CRITICAL(&g_fade_lock);
+  g_fade.count = 0;
+  g_fade.active = false;
+  portEXIT_CRITICAL(&g_fade_lock);
+}
+
+bool HAL::Backlight_IsGradually(void) {
+  return g_fade.active;
+}
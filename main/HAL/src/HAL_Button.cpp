@@ -1,26 +1,60 @@
 #include "../inc/HAL.h"
 #include "button_gpio.h"
 #include "iot_button.h"
+#include "esp_timer.h"
+#include <atomic>
 
-// 全局变量用于存储按键状态，供 LVGL 输入设备读取
-volatile key_action_t g_key_action = KEY_ACTION_NONE;
+// 按键事件环形队列，单生产者(按键回调)单消费者(LVGL 输入设备)，无锁
+#define KEY_EVENT_QUEUE_SIZE 16 // 必须是 2 的幂
+
+static key_event_t g_key_events[KEY_EVENT_QUEUE_SIZE];
+static std::atomic<uint32_t> g_key_head(0); // 只由按键回调写
+static std::atomic<uint32_t> g_key_tail(0); // 只由读取方写
+
+// 最近一次按下的时间，由按键扫描定时器检测到按下时记录
+static volatile uint32_t g_key_down_us = 0;
+
+// 有新事件时的通知回调，用于唤醒GUI任务
+static HAL::Button_CallbackFunc_t g_key_event_cb = nullptr;
+
+// 按键回调中调用，队列满时丢弃新事件
+static void key_event_push(key_action_t action) {
+  uint32_t head = g_key_head.load(std::memory_order_relaxed);
+  if (head - g_key_tail.load(std::memory_order_acquire) >= KEY_EVENT_QUEUE_SIZE) {
+    return;
+  }
+  key_event_t *event = &g_key_events[head & (KEY_EVENT_QUEUE_SIZE - 1)];
+  event->action = action;
+  event->time_us = (uint32_t)esp_timer_get_time();
+  event->down_us = g_key_down_us;
+  g_key_head.store(head + 1, std::memory_order_release);
+
+  if (g_key_event_cb) {
+    g_key_event_cb();
+  }
+}
+
+// 按下回调函数
+static void functionKey_press_down_event_cb(void *arg, void *data) {
+  g_key_down_us = (uint32_t)esp_timer_get_time();
+}
 
 // 三击回调函数
 static void functionKey_triple_click_event_cb(void *arg, void *data) {
-  // 只设置按键动作，不执行具体操作
-  g_key_action = KEY_ACTION_TRIPLE_CLICK;
+  // 只记录按键动作，不执行具体操作
+  key_event_push(KEY_ACTION_TRIPLE_CLICK);
 }
 
 // 双击回调函数
 static void functionKey_double_click_event_cb(void *arg, void *data) {
-  // 只设置按键动作，不执行具体操作
-  g_key_action = KEY_ACTION_DOUBLE_CLICK;
+  // 只记录按键动作，不执行具体操作
+  key_event_push(KEY_ACTION_DOUBLE_CLICK);
 }
 
 // 单击回调函数
 static void functionKey_click_event_cb(void *arg, void *data) {
-  // 只设置按键动作，不执行具体操作
-  g_key_action = KEY_ACTION_SINGLE_CLICK;
+  // 只记录按键动作，不执行具体操作
+  key_event_push(KEY_ACTION_SINGLE_CLICK);
 }
 
 /*FUNCTION*/
@@ -52,6 +86,8 @@ void HAL::Button_Init(void) {
       }
   };
   
+  iot_button_register_cb(functionKey, BUTTON_PRESS_DOWN, NULL,
+                         functionKey_press_down_event_cb, nullptr);
   iot_button_register_cb(functionKey, BUTTON_MULTIPLE_CLICK, &triple_click_args,
                          functionKey_triple_click_event_cb, nullptr);
   iot_button_register_cb(functionKey, BUTTON_DOUBLE_CLICK, NULL,
@@ -60,9 +96,24 @@ void HAL::Button_Init(void) {
                          functionKey_click_event_cb, nullptr);
 }
 
-// 获取当前按键动作，供LVGL输入设备读取
+// 设置新按键事件的通知回调，在按键回调的上下文中调用
+void HAL::Button_SetEventCallback(Button_CallbackFunc_t func) {
+  g_key_event_cb = func;
+}
+
+// 取出最早的按键事件，供LVGL输入设备读取，没有事件时返回 false
+bool HAL::Button_GetEvent(key_event_t *event) {
+  uint32_t tail = g_key_tail.load(std::memory_order_relaxed);
+  if (tail == g_key_head.load(std::memory_order_acquire)) {
+    return false;
+  }
+  *event = g_key_events[tail & (KEY_EVENT_QUEUE_SIZE - 1)];
+  g_key_tail.store(tail + 1, std::memory_order_release);
+  return true;
+}
+
+// 获取最早的按键动作，没有时返回 KEY_ACTION_NONE
 key_action_t HAL::Button_GetAction(void) {
-  key_action_t action = g_key_action;
-  g_key_action = KEY_ACTION_NONE; // 读取后清除动作状态
-  return action;
-}
\ No newline at end of file
+  key_event_t event;
+  return HAL::Button_GetEvent(&event) ? event.action : KEY_ACTION_NONE;
+}
@@ -1,18 +1,29 @@
 #include "../inc/HAL.h"
-#include "lvgl.h"
 #include <Arduino_GFX_Library.h>
 
+#if CONFIG_SCREEN_STATIC_DISPATCH
+Arduino_ESP32SPIDMA *bus = new Arduino_ESP32SPIDMA(
+    CONFIG_SCREEN_DC_PIN /* DC */, CONFIG_SCREEN_CS_PIN /* CS */,
+    CONFIG_SCREEN_SCK_PIN /* SCK */, CONFIG_SCREEN_MOSI_PIN /* MOSI */,
+    GFX_NOT_DEFINED /* MISO */);
+Arduino_ST7789 *gfx = new Arduino_TFT_Static<Arduino_ST7789, Arduino_ESP32SPIDMA>(
+    bus, CONFIG_SCREEN_RST_PIN /* RST */, 0 /* rotation */, true /* IPS */,
+    170 /* width */, 320 /* height */, 35 /* col offset 1 */,
+    0 /* row offset 1 */, 35 /* col offset 2 */, 0 /* row offset 2 */);
+#else
 Arduino_DataBus *bus = new Arduino_ESP32SPIDMA(
     CONFIG_SCREEN_DC_PIN /* DC */, CONFIG_SCREEN_CS_PIN /* CS */,
     CONFIG_SCREEN_SCK_PIN /* SCK */, CONFIG_SCREEN_MOSI_PIN /* MOSI */,
     GFX_NOT_DEFINED /* MISO */);
-Arduino_GFX *gfx = new Arduino_ST7789(
+Arduino_ST7789 *gfx = new Arduino_ST7789(
     bus, CONFIG_SCREEN_RST_PIN /* RST */, 0 /* rotation */, true /* IPS */,
     170 /* width */, 320 /* height */, 35 /* col offset 1 */,
     0 /* row offset 1 */, 35 /* col offset 2 */, 0 /* row offset 2 */);
+#endif
 
-
-
+// 硬件滚动: 待生效的偏移, 在一帧发送完成后写入屏幕
+static int32_t scrollPending = 0;
+static bool scrollDirty = false;
 
 void HAL::Display_Init(void) {
   // 初始化SPI和显示屏 - 使用定义的配置
@@ -35,38 +46,38 @@ void HAL::Display_SendPixels(uint32_t x, uint32_t y, uint32_t w, uint32_t h,
   // #endif
 }
 
-void HAL::Backlight_Init(void) {
-#ifdef CONFIG_SCREEN_BLK_PIN
-  ledcAttach(CONFIG_SCREEN_BLK_PIN, 5000, 12);
-  // Attach the backlight pin to PWM channel 0
-  ledcWrite(CONFIG_SCREEN_BLK_PIN, 0);
-  // Set the backlight to maximum brightness
-#endif
+bool HAL::Display_IsScrollHorizontal(void) {
+  return gfx->isScrollHorizontal();
 }
 
-void HAL::Backlight_SetVal(uint16_t brightness) {
-#ifdef CONFIG_SCREEN_BLK_PIN
-  ledcWrite(CONFIG_SCREEN_BLK_PIN, brightness);
-#endif
+void HAL::Display_ScrollBegin(void) {
+  scrollDirty = false;
+  gfx->scrollBegin();
 }
 
-uint16_t HAL::Backlight_GetVal(void) {
-#ifdef CONFIG_SCREEN_BLK_PIN
-  return ledcRead(CONFIG_SCREEN_BLK_PIN);
-#endif
+void HAL::Display_ScrollTo(int32_t offset) {
+  // 先发送新露出的像素, 再移动画面, 避免显示未刷新的区域
+  scrollPending = offset;
+  scrollDirty = true;
 }
 
-void Backlight_AnimCallback(void *var, int32_t val) {
-  HAL::Backlight_SetVal(val);
+void HAL::Display_ScrollCommit(void) {
+  if (scrollDirty) {
+    scrollDirty = false;
+    gfx->scrollTo(scrollPending);
+  }
 }
 
-void HAL::Backlight_SetGradually(uint16_t target, uint16_t time_ms) {
-  lv_anim_t a;
-  lv_anim_init(&a);
-  lv_anim_set_exec_cb(&a, (lv_anim_exec_xcb_t)Backlight_AnimCallback);
-  lv_anim_set_values(&a, Backlight_GetVal(), target);
-  lv_anim_set_time(&a, time_ms);
-  lv_anim_set_path_cb(&a, lv_anim_path_ease_out);
+void HAL::Display_ScrollEnd(void) {
+  scrollDirty = false;
+  gfx->scrollEnd();
+}
 
-  lv_anim_start(&a);
-}
\ No newline at end of file
+void HAL::Display_SetSleep(bool en) {
+  // 睡眠时屏幕保留显存内容, 唤醒后无需重绘
+  if (en) {
+    gfx->sleepIn();
+  } else {
+    gfx->sleepOut();
+  }
+}
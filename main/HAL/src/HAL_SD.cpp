@@ -0,0 +1,194 @@
+#include "../inc/HAL.h"
+
+#if CONFIG_SD_ENABLE
+#include "esp_vfs_fat.h"
+#include "sdmmc_cmd.h"
+#include "driver/sdspi_host.h"
+#include "driver/spi_common.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+
+#define SD_MAX_FILES    4    // 同时打开的文件数
+#define SD_MAX_TRANSFER 4096 // 单次 DMA 传输的最大长度 [byte]
+#define SD_FREQ_KHZ     SDMMC_FREQ_DEFAULT
+
+static sdmmc_card_t *g_card = NULL;
+static bool g_card_insert = false;
+static uint32_t g_mount_id = 0; // 每次挂载加一，0 = 未挂载
+static uint32_t g_mount_cnt = 0;
+
+// 保护挂载状态，卸载时不能有文件正在读写
+static SemaphoreHandle_t g_sd_mutex = NULL;
+
+static bool sd_card_detect(void) {
+#if CONFIG_SD_CD_PIN >= 0
+  return digitalRead(CONFIG_SD_CD_PIN) == LOW;
+#else
+  return true;
+#endif
+}
+
+static bool sd_mount(void) {
+  esp_vfs_fat_sdmmc_mount_config_t mount_config = {};
+  mount_config.format_if_mount_failed = false;
+  mount_config.max_files = SD_MAX_FILES;
+  mount_config.allocation_unit_size = 16 * 1024;
+
+  sdmmc_host_t host = SDSPI_HOST_DEFAULT();
+  host.slot = CONFIG_SD_SPI;
+  host.max_freq_khz = SD_FREQ_KHZ;
+
+  sdspi_device_config_t slot_config = SDSPI_DEVICE_CONFIG_DEFAULT();
+  slot_config.gpio_cs = (gpio_num_t)CONFIG_SD_CS_PIN;
+  slot_config.host_id = (spi_host_device_t)CONFIG_SD_SPI;
+
+  esp_err_t err = esp_vfs_fat_sdspi_mount(CONFIG_SD_MOUNT_POINT, &host, &slot_config,
+                                          &mount_config, &g_card);
+  if (err != ESP_OK) {
+    SD_PRINTF("SD mount failed: %s\n", esp_err_to_name(err));
+    g_card = NULL;
+    return false;
+  }
+
+  xSemaphoreTake(g_sd_mutex, portMAX_DELAY);
+  g_mount_cnt++;
+  if (g_mount_cnt == 0) {
+    g_mount_cnt = 1;
+  }
+  g_mount_id = g_mount_cnt;
+  xSemaphoreGive(g_sd_mutex);
+
+  SD_PRINTF("SD mounted: %s, %.1f MB\n", HAL::SD_GetCardInfo(), HAL::SD_GetCardSizeMB());
+  return true;
+}
+
+static void sd_unmount(void) {
+  if (g_card == NULL) {
+    return;
+  }
+
+  // 等待正在进行的读写结束，之后旧的文件句柄全部失效
+  xSemaphoreTake(g_sd_mutex, portMAX_DELAY);
+  g_mount_id = 0;
+  esp_vfs_fat_sdcard_unmount(CONFIG_SD_MOUNT_POINT, g_card);
+  g_card = NULL;
+  xSemaphoreGive(g_sd_mutex);
+
+  SD_PRINTF("SD unmounted\n");
+}
+
+bool HAL::SD_Init(void) {
+  g_sd_mutex = xSemaphoreCreateMutex();
+
+  // SD 卡使用单独的 SPI 总线，读取时由 DMA 直接写入缓冲区
+  spi_bus_config_t bus_config = {};
+  bus_config.mosi_io_num = CONFIG_SD_MOSI_PIN;
+  bus_config.miso_io_num = CONFIG_SD_MISO_PIN;
+  bus_config.sclk_io_num = CONFIG_SD_SCK_PIN;
+  bus_config.quadwp_io_num = -1;
+  bus_config.quadhd_io_num = -1;
+  bus_config.max_transfer_sz = SD_MAX_TRANSFER;
+
+  esp_err_t err = spi_bus_initialize((spi_host_device_t)CONFIG_SD_SPI, &bus_config, SPI_DMA_CH_AUTO);
+  if (err != ESP_OK) {
+    SD_PRINTF("SD SPI init failed: %s\n", esp_err_to_name(err));
+    return false;
+  }
+
+#if CONFIG_SD_CD_PIN >= 0
+  pinMode(CONFIG_SD_CD_PIN, INPUT_PULLUP);
+#endif
+
+  g_card_insert = sd_card_detect();
+  if (!g_card_insert) {
+    SD_PRINTF("SD card not inserted\n");
+    return false;
+  }
+
+  return sd_mount();
+}
+
+void HAL::SD_Update(void) {
+  // 周期调用，检测插拔
+  bool insert = sd_card_detect();
+  if (insert == g_card_insert) {
+    return;
+  }
+  g_card_insert = insert;
+
+  if (insert) {
+    sd_mount();
+  } else {
+    sd_unmount();
+  }
+}
+
+float HAL::SD_GetCardSizeMB() {
+  if (g_card == NULL) {
+    return 0;
+  }
+  return (float)g_card->csd.capacity * g_card->csd.sector_size / (1024 * 1024);
+}
+
+const char *HAL::SD_GetCardInfo(void) {
+  if (g_card == NULL) {
+    return "NONE";
+  }
+  if (g_card->is_sdio) {
+    return "SDIO";
+  }
+  if (g_card->is_mmc) {
+    return "MMC";
+  }
+  return (g_card->ocr & SD_OCR_SDHC_CAP) ? "SDHC/SDXC" : "SDSC";
+}
+
+bool HAL::SD_GetReady(void) {
+  return g_mount_id != 0;
+}
+
+uint32_t HAL::SD_Lock(void) {
+  // 返回当前挂载编号，打开文件时记录，不一致说明卡已被拔出或重新挂载
+  if (g_sd_mutex == NULL) {
+    return 0;
+  }
+  xSemaphoreTake(g_sd_mutex, portMAX_DELAY);
+  return g_mount_id;
+}
+
+void HAL::SD_Unlock(void) {
+  if (g_sd_mutex != NULL) {
+    xSemaphoreGive(g_sd_mutex);
+  }
+}
+
+#else
+
+// 未使用 SD 卡：不占用 SPI 总线和引脚，始终为未挂载状态
+bool HAL::SD_Init(void) {
+  return false;
+}
+
+void HAL::SD_Update(void) {
+}
+
+float HAL::SD_GetCardSizeMB() {
+  return 0;
+}
+
+const char *HAL::SD_GetCardInfo(void) {
+  return "NONE";
+}
+
+bool HAL::SD_GetReady(void) {
+  return false;
+}
+
+uint32_t HAL::SD_Lock(void) {
+  return 0;
+}
+
+void HAL::SD_Unlock(void) {
+}
+
+#endif
@@ -0,0 +1,304 @@
+#include "../inc/HAL.h"
+#include "nvs.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#define SETTINGS_NAMESPACE        "settings"
+#define SETTINGS_MAX_NUM          32    // 最多保存的设置项
+#define SETTINGS_KEY_SIZE         16    // NVS 键名最长 15 字符
+#define SETTINGS_BLOB_SIZE        32    // 单个二进制设置项的最大长度
+#define SETTINGS_COMMIT_DELAY     2000  // 最后一次修改后等待多久写入 [ms]
+#define SETTINGS_COMMIT_MAX_DELAY 10000 // 第一次修改后最迟多久写入 [ms]
+#define SETTINGS_COMMIT_INTERVAL  5000  // 两次写入 flash 的最短间隔 [ms]
+
+typedef enum {
+  SETTINGS_TYPE_NONE = 0,
+  SETTINGS_TYPE_INT,
+  SETTINGS_TYPE_BLOB,
+} Settings_Type_t;
+
+typedef struct {
+  char key[SETTINGS_KEY_SIZE];
+  uint8_t type;  // Settings_Type_t
+  uint8_t size;  // BLOB 长度
+  bool dirty;    // RAM 中的值还未写入 flash
+  union {
+    int32_t i32;
+    uint8_t blob[SETTINGS_BLOB_SIZE];
+  } value;
+} Settings_Entry_t;
+
+// 启动时从 NVS 读入，之后读取只访问这里
+static Settings_Entry_t g_settings[SETTINGS_MAX_NUM];
+static uint32_t g_settings_num = 0;
+static uint32_t g_dirty_tick = 0;        // 第一次修改的时间
+static uint32_t g_change_tick = 0;       // 最后一次修改的时间
+static uint32_t g_commit_tick = 0;       // 最后一次写入 flash 的时间，0 = 还未写入
+
+static SemaphoreHandle_t g_settings_mutex = NULL;
+// 串行化写入，后台任务和 Settings_Commit 共用写入缓冲区
+static SemaphoreHandle_t g_commit_mutex = NULL;
+static TaskHandle_t g_settings_task = NULL;
+
+static Settings_Entry_t *settings_find(const char *key) {
+  for (uint32_t i = 0; i < g_settings_num; i++) {
+    if (strcmp(g_settings[i].key, key) == 0) {
+      return &g_settings[i];
+    }
+  }
+  return NULL;
+}
+
+static Settings_Entry_t *settings_add(const char *key, Settings_Type_t type) {
+  if (g_settings_num >= SETTINGS_MAX_NUM || strlen(key) >= SETTINGS_KEY_SIZE) {
+    FS_PRINTF("Settings(%s) can't be added\n", key);
+    return NULL;
+  }
+  Settings_Entry_t *entry = &g_settings[g_settings_num++];
+  memset(entry, 0, sizeof(Settings_Entry_t));
+  strcpy(entry->key, key);
+  entry->type = type;
+  return entry;
+}
+
+// 修改设置项，值没有变化时不写 flash
+static bool settings_set(const char *key, Settings_Type_t type, const void *data, size_t size) {
+  bool ret = false;
+  xSemaphoreTake(g_settings_mutex, portMAX_DELAY);
+
+  Settings_Entry_t *entry = settings_find(key);
+  if (entry == NULL) {
+    entry = settings_add(key, type);
+  }
+
+  if (entry != NULL && entry->type == type) {
+    void *value = (type == SETTINGS_TYPE_INT) ? (void *)&entry->value.i32 : (void *)entry->value.blob;
+    if (entry->size != size || memcmp(value, data, size) != 0) {
+      memcpy(value, data, size);
+      entry->size = size;
+
+      uint32_t tick = millis();
+      if (!entry->dirty) {
+        entry->dirty = true;
+        if (g_dirty_tick == 0) {
+          g_dirty_tick = tick ? tick : 1;
+        }
+      }
+      g_change_tick = tick;
+    }
+    ret = true;
+  }
+
+  xSemaphoreGive(g_settings_mutex);
+
+  if (ret && g_settings_task) {
+    xTaskNotifyGive(g_settings_task);
+  }
+  return ret;
+}
+
+static bool settings_get(const char *key, Settings_Type_t type, void *data, size_t size) {
+  bool ret = false;
+  xSemaphoreTake(g_settings_mutex, portMAX_DELAY);
+
+  Settings_Entry_t *entry = settings_find(key);
+  if (entry != NULL && entry->type == type && entry->size <= size) {
+    memcpy(data, (type == SETTINGS_TYPE_INT) ? (void *)&entry->value.i32 : (void *)entry->value.blob, entry->size);
+    ret = true;
+  }
+
+  xSemaphoreGive(g_settings_mutex);
+  return ret;
+}
+
+// 写入失败的设置项重新标记为待写入，由后台任务在 SETTINGS_COMMIT_INTERVAL 后重试
+// 复制之后又被修改过的项本来就是 dirty，下次写入的是新值
+static void settings_mark_dirty(const uint8_t *index, uint32_t num) {
+  if (num == 0) {
+    return;
+  }
+
+  xSemaphoreTake(g_settings_mutex, portMAX_DELAY);
+  for (uint32_t i = 0; i < num; i++) {
+    g_settings[index[i]].dirty = true;
+  }
+  if (g_dirty_tick == 0) {
+    uint32_t tick = millis();
+    g_dirty_tick = tick ? tick : 1;
+  }
+  xSemaphoreGive(g_settings_mutex);
+}
+
+// 把修改过的设置项一次性写入 flash，只提交一次，返回是否全部写入
+static bool settings_commit(void) {
+  static Settings_Entry_t dirty[SETTINGS_MAX_NUM];
+  static uint8_t index[SETTINGS_MAX_NUM];   // dirty[i] 在 g_settings 中的位置
+  static uint8_t failed[SETTINGS_MAX_NUM];
+  uint32_t num = 0;
+  uint32_t failed_num = 0;
+
+  xSemaphoreTake(g_commit_mutex, portMAX_DELAY);
+
+  // 先复制出来，写 flash 时不占用锁，UI 的读写不会等待 flash
+  xSemaphoreTake(g_settings_mutex, portMAX_DELAY);
+  for (uint32_t i = 0; i < g_settings_num; i++) {
+    if (g_settings[i].dirty) {
+      index[num] = i;
+      dirty[num++] = g_settings[i];
+      g_settings[i].dirty = false;
+    }
+  }
+  g_dirty_tick = 0;
+  xSemaphoreGive(g_settings_mutex);
+
+  if (num == 0) {
+    xSemaphoreGive(g_commit_mutex);
+    return true;
+  }
+
+  nvs_handle_t handle;
+  esp_err_t err = nvs_open(SETTINGS_NAMESPACE, NVS_READWRITE, &handle);
+  if (err != ESP_OK) {
+    FS_PRINTF("Settings open failed: %s\n", esp_err_to_name(err));
+    settings_mark_dirty(index, num);
+  } else {
+    for (uint32_t i = 0; i < num; i++) {
+      if (dirty[i].type == SETTINGS_TYPE_INT) {
+        err = nvs_set_i32(handle, dirty[i].key, dirty[i].value.i32);
+      } else {
+        err = nvs_set_blob(handle, dirty[i].key, dirty[i].value.blob, dirty[i].size);
+      }
+      if (err != ESP_OK) {
+        FS_PRINTF("Settings(%s) write failed: %s\n", dirty[i].key, esp_err_to_name(err));
+        failed[failed_num++] = index[i];
+      }
+    }
+
+    err = nvs_commit(handle);
+    nvs_close(handle);
+    FS_PRINTF("Settings commit %lu items: %s\n", num - failed_num, esp_err_to_name(err));
+
+    // 提交失败时不确定哪些已经写入，全部重试
+    if (err != ESP_OK) {
+      settings_mark_dirty(index, num);
+    } else {
+      settings_mark_dirty(failed, failed_num);
+    }
+  }
+
+  uint32_t tick = millis();
+  g_commit_tick = tick ? tick : 1;
+  bool ret = (err == ESP_OK && failed_num == 0);
+  xSemaphoreGive(g_commit_mutex);
+  return ret;
+}
+
+// 后台任务，合并短时间内的修改后再写入
+static void settings_task(void *arg) {
+  while (1) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    while (1) {
+      xSemaphoreTake(g_settings_mutex, portMAX_DELAY);
+      uint32_t dirty_tick = g_dirty_tick;
+      uint32_t change_tick = g_change_tick;
+      uint32_t commit_tick = g_commit_tick;
+      xSemaphoreGive(g_settings_mutex);
+
+      if (dirty_tick == 0) {
+        break;
+      }
+
+      // 值还在变化时继续等待，但不超过最大延时
+      uint32_t now = millis();
+      uint32_t wait = 0;
+      if (now - change_tick < SETTINGS_COMMIT_DELAY && now - dirty_tick < SETTINGS_COMMIT_MAX_DELAY) {
+        wait = SETTINGS_COMMIT_DELAY - (now - change_tick);
+      }
+      if (commit_tick != 0 && now - commit_tick < SETTINGS_COMMIT_INTERVAL) {
+        uint32_t interval_wait = SETTINGS_COMMIT_INTERVAL - (now - commit_tick);
+        wait = (interval_wait > wait) ? interval_wait : wait;
+      }
+
+      if (wait > 0) {
+        // 期间的新修改只会再次通知，不影响这里的判断
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(wait));
+        continue;
+      }
+
+      // 失败的项已重新标记，循环会在写入间隔之后重试
+      settings_commit();
+    }
+  }
+}
+
+void HAL::Settings_Init(void) {
+  g_settings_mutex = xSemaphoreCreateMutex();
+  g_commit_mutex = xSemaphoreCreateMutex();
+
+  // 读入全部设置项
+  nvs_iterator_t it = NULL;
+  esp_err_t err = nvs_entry_find(NVS_DEFAULT_PART_NAME, SETTINGS_NAMESPACE, NVS_TYPE_ANY, &it);
+
+  nvs_handle_t handle;
+  bool is_open = (err == ESP_OK) && (nvs_open(SETTINGS_NAMESPACE, NVS_READONLY, &handle) == ESP_OK);
+
+  while (err == ESP_OK && is_open) {
+    nvs_entry_info_t info;
+    nvs_entry_info(it, &info);
+
+    Settings_Entry_t *entry = NULL;
+    if (info.type == NVS_TYPE_I32 && (entry = settings_add(info.key, SETTINGS_TYPE_INT)) != NULL) {
+      nvs_get_i32(handle, info.key, &entry->value.i32);
+      entry->size = sizeof(int32_t);
+    } else if (info.type == NVS_TYPE_BLOB && (entry = settings_add(info.key, SETTINGS_TYPE_BLOB)) != NULL) {
+      size_t size = SETTINGS_BLOB_SIZE;
+      if (nvs_get_blob(handle, info.key, entry->value.blob, &size) == ESP_OK) {
+        entry->size = size;
+      } else {
+        g_settings_num--;
+      }
+    }
+
+    err = nvs_entry_next(&it);
+  }
+
+  if (is_open) {
+    nvs_close(handle);
+  }
+  nvs_release_iterator(it);
+
+  FS_PRINTF("Settings loaded %lu items\n", g_settings_num);
+
+  xTaskCreate(settings_task, "settings", 3 * 1024, NULL, 1, &g_settings_task);
+}
+
+int32_t HAL::Settings_GetInt(const char *key, int32_t def) {
+  int32_t value;
+  return settings_get(key, SETTINGS_TYPE_INT, &value, sizeof(value)) ? value : def;
+}
+
+bool HAL::Settings_SetInt(const char *key, int32_t value) {
+  return settings_set(key, SETTINGS_TYPE_INT, &value, sizeof(value));
+}
+
+bool HAL::Settings_GetBlob(const char *key, void *data, size_t size) {
+  return settings_get(key, SETTINGS_TYPE_BLOB, data, size);
+}
+
+bool HAL::Settings_SetBlob(const char *key, const void *data, size_t size) {
+  if (size > SETTINGS_BLOB_SIZE) {
+    FS_PRINTF("Settings(%s) size %u too large\n", key, (unsigned)size);
+    return false;
+  }
+  return settings_set(key, SETTINGS_TYPE_BLOB, data, size);
+}
+
+void HAL::Settings_Commit(void) {
+  // 关机或重启前调用，立即写入，与后台任务的写入互斥
+  if (!settings_commit() && g_settings_task) {
+    // 失败的项交给后台任务重试
+    xTaskNotifyGive(g_settings_task);
+  }
+}
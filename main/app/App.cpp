@@ -4,6 +4,7 @@
 #include "PageManager.h"
 #include "AppFactory.h"
 #include "App.h"
+#include "../HAL/inc/HAL.h"
 
 void App_Init(void)
 {
@@ -35,6 +36,25 @@ void App_Init(void)
 
     manager.SetRootDefaultStyle(&rootStyle);
 
+    /* Keep the cached pages within half of the LVGL heap */
+    manager.SetCacheBudget(LV_MEM_SIZE / 2);
+
+    /* Each page keeps its own focus group, swapped in when it appears */
+    manager.SetFocusGroupEnable(true);
+
+    /* Slide page snapshots (kept in PSRAM) instead of redrawing the widgets */
+    manager.SetSnapshotAnimEnable(true);
+
+    /* Slide the MOVE animations along the panel rows with the ST7789 scroll */
+    static PageManager::ScrollBackend_t scrollBackend;
+    scrollBackend.dir = HAL::Display_IsScrollHorizontal()
+                        ? PageManager::ROOT_DRAG_DIR_HOR
+                        : PageManager::ROOT_DRAG_DIR_VER;
+    scrollBackend.begin = HAL::Display_ScrollBegin;
+    scrollBackend.scroll = HAL::Display_ScrollTo;
+    scrollBackend.end = HAL::Display_ScrollEnd;
+    manager.SetScrollBackend(&scrollBackend);
+
     /* Initialize resource pool */
     ResourcePool::Init();
 }
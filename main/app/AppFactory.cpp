@@ -5,21 +5,16 @@
 // #include "SystemInfos/SystemInfos.h"
 // #include "StartUp/StartUp.h"
 
-#define APP_CLASS_MATCH(className)\
-do{\
-    if (strcmp(name, #className) == 0)\
-    {\
-        return new Page::className;\
-    }\
-}while(0)
-
+/**
+  * Pages register themselves in their source file and are installed
+  * without going through this factory:
+  *   PAGE_REGISTER(Page::Template, Template);
+  *   manager.Install<Page::Template>("Template");
+  *   manager.Install(PageRegistry::NameHash("Template"), "Template");
+  * The factory is only asked for the class names that are not registered.
+  */
 PageBase* AppFactory::CreatePage(const char* name)
 {
-    // APP_CLASS_MATCH(Template);
-    // APP_CLASS_MATCH(LiveMap);
-    // APP_CLASS_MATCH(Dialplate);
-    // APP_CLASS_MATCH(SystemInfos);;
-    // APP_CLASS_MATCH(Startup);
     printf("AppFactory::CreatePage(%s)\n", name);
 
     return nullptr;
@@ -7,6 +7,17 @@
 #include <esp_timer.h>
 #include <lvgl.h>
 
+/* 事件驱动输入: 按键通知GUI任务后立即读取，输入设备定时器暂停 */
+#define LV_PORT_INDEV_EVENT_DRIVEN 1
+
+/* 输入到屏幕的延时测量: 记录一次按键经过各阶段的时间，统计百分位 */
+#ifndef LV_PORT_LATENCY_TRACE
+#define LV_PORT_LATENCY_TRACE 0
+#endif
+
+/* GUI任务通知位 */
+#define LV_PORT_NOTIFY_INDEV (1UL << 0)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -20,12 +31,68 @@ void lv_port_disp_init(void);
 /* 输入设备初始化 */
 void lv_port_indev_init(void);
 
+/* 通知GUI任务，可在其他任务中调用 */
+void lv_port_gui_notify(uint32_t bits);
+
+/* 立即读取输入设备，返回本次送出的第一个按键的时间 [us]，没有按键时返回0 */
+uint32_t lv_port_indev_read(void);
+
+/* 按键到屏幕刷新完成的延时 [us] */
+void lv_port_get_input_latency(uint32_t *last_us, uint32_t *max_us);
+
+#if LV_PORT_LATENCY_TRACE
+/* 延时测量的阶段 */
+typedef enum {
+    LV_PORT_LATENCY_DOWN = 0,   // 按键扫描检测到按下
+    LV_PORT_LATENCY_CLICK,      // 按键回调识别出单击/双击
+    LV_PORT_LATENCY_READ,       // keypad_read 送出按键
+    LV_PORT_LATENCY_EVENT,      // LVGL 向控件派发输入事件
+    LV_PORT_LATENCY_INVALIDATE, // 第一次标记需要重绘的区域
+    LV_PORT_LATENCY_FLUSH,      // 第一次调用 disp_flush_cb
+    LV_PORT_LATENCY_DONE,       // 最后一块像素发送完毕
+    _LV_PORT_LATENCY_LAST
+} lv_port_latency_stage_t;
+
+/* 开始记录一次按键 */
+void lv_port_latency_begin(uint32_t down_us, uint32_t click_us);
+
+/* 记录阶段的第一次到达，到达 DONE 时保存为一个样本 */
+void lv_port_latency_mark(lv_port_latency_stage_t stage);
+
+/* 打印各阶段相对于按下的延时百分位 */
+void lv_port_latency_report(void);
+#endif
+
+/* 无操作超过 timeout_ms 后关闭背光和屏幕并挂起GUI任务，按键唤醒，0 = 禁用
+ * 依赖按键通知唤醒，仅 LV_PORT_INDEV_EVENT_DRIVEN 时有效 */
+void lv_port_set_idle_timeout(uint32_t timeout_ms);
+
+/* 功耗相关统计 */
+typedef struct {
+    uint32_t period_ms;       // 统计时长，自上次读取起
+    uint32_t gui_wakeups;     // GUI任务唤醒次数
+    uint32_t tick_wakeups;    // LVGL tick 定时器唤醒次数
+    uint32_t sleep_ms;        // 屏幕睡眠时长
+    uint32_t wake_latency_us; // 最近一次按键到屏幕恢复的延时
+} lv_port_power_stat_t;
+
+/* 读取功耗统计并开始新的统计周期 */
+void lv_port_get_power_stat(lv_port_power_stat_t *stat);
+
 /* 焦点初始化 - 为指定屏幕上的控件添加焦点 */
 void lv_port_focus_init(lv_obj_t *screen);
 
 /* 文件系统初始化 */
 void lv_port_fs_init(void);
 
+/* LittleFS 资源分区 (webfs)，挂载到 /webfs，LVGL 中以 "L:/xxx" 访问 */
+#define LV_PORT_FS_LITTLEFS_LETTER 'L'
+void lv_port_fs_littlefs_init(void);
+
+/* SD 卡，挂载到 CONFIG_SD_MOUNT_POINT，LVGL 中以 "S:/xxx" 访问，双缓冲顺序读取 */
+#define LV_PORT_FS_SD_LETTER 'S'
+void lv_port_fs_sdfat_init(void);
+
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
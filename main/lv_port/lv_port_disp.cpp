@@ -12,6 +12,26 @@ static lv_color_t *buf2 = (lv_color_t *)heap_caps_malloc(SCREEN_BUFFER_SIZE * si
 static lv_color_t *buf1 = (lv_color_t *)heap_caps_malloc(SCREEN_BUFFER_SIZE * sizeof(lv_color_t), MALLOC_CAP_DMA);
 #endif
 
+#define GUI_TASK_SLEEP_MAX 100 // GUI任务无事可做时的最长睡眠时间 [ms]
+
+static uint32_t g_frame_done_us = 0; // 最近一帧发送完毕的时间
+
+// 按键到屏幕刷新完成的延时统计
+static uint32_t g_input_latency_last_us = 0;
+static uint32_t g_input_latency_max_us = 0;
+
+#define IDLE_WAKE_BUDGET_US 20000 // 按键到屏幕恢复的延时预算 [us]
+
+static esp_timer_handle_t g_tick_timer = NULL;
+static uint32_t g_idle_timeout_ms = 0; // 无操作多久后进入睡眠，0 = 禁用
+
+// 功耗统计，lv_port_get_power_stat 读取后清零
+static volatile uint32_t g_tick_wakeups = 0;
+static uint32_t g_gui_wakeups = 0;
+static uint32_t g_sleep_ms = 0;
+static uint32_t g_wake_latency_us = 0;
+static int64_t g_stat_start_us = 0;
+
 // LVGL显示刷新回调函数
 static void disp_flush_cb(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t *color_p)
 {
@@ -19,33 +39,212 @@ static void disp_flush_cb(lv_disp_drv_t *disp, const lv_area_t *area, lv_color_t
     const lv_coord_t w = (area->x2 - area->x1 + 1);
     const lv_coord_t h = (area->y2 - area->y1 + 1);
 
+#if LV_PORT_LATENCY_TRACE
+    lv_port_latency_mark(LV_PORT_LATENCY_FLUSH);
+#endif
+
     // 发送像素数据到LCD
     HAL::Display_SendPixels(area->x1, area->y1, w, h, (uint16_t *)color_p);
 
+    // 本帧像素发送完毕后再应用硬件滚动偏移
+    if (lv_disp_flush_is_last(disp))
+    {
+        HAL::Display_ScrollCommit();
+        g_frame_done_us = (uint32_t)esp_timer_get_time();
+#if LV_PORT_LATENCY_TRACE
+        // 像素数据以阻塞方式发送，返回时 DMA 已完成
+        lv_port_latency_mark(LV_PORT_LATENCY_DONE);
+#endif
+    }
+
     // 通知LVGL刷新完成
     lv_disp_flush_ready(disp);
 }
 
+#if LV_PORT_LATENCY_TRACE
+// 每次标记重绘区域时调用，只用于记录时间，不修改区域
+static void disp_rounder_cb(lv_disp_drv_t *disp, lv_area_t *area)
+{
+    lv_port_latency_mark(LV_PORT_LATENCY_INVALIDATE);
+}
+#endif
+
 static TaskHandle_t g_lvgl_task_handle = NULL;
 
 static SemaphoreHandle_t xGuiSemaphore = NULL;
 
+// 通知GUI任务，提前结束睡眠
+void lv_port_gui_notify(uint32_t bits)
+{
+    if (g_lvgl_task_handle)
+    {
+        xTaskNotify(g_lvgl_task_handle, bits, eSetBits);
+    }
+}
+
+void lv_port_get_input_latency(uint32_t *last_us, uint32_t *max_us)
+{
+    *last_us = g_input_latency_last_us;
+    *max_us = g_input_latency_max_us;
+}
+
+void lv_port_set_idle_timeout(uint32_t timeout_ms)
+{
+#if !LV_PORT_INDEV_EVENT_DRIVEN
+    if (timeout_ms != 0)
+    {
+        DISPLAY_PRINTF("Idle sleep needs LV_PORT_INDEV_EVENT_DRIVEN, ignored\n");
+    }
+#endif
+    g_idle_timeout_ms = timeout_ms;
+}
+
+void lv_port_get_power_stat(lv_port_power_stat_t *stat)
+{
+    int64_t now = esp_timer_get_time();
+    stat->period_ms = (uint32_t)((now - g_stat_start_us) / 1000);
+    stat->gui_wakeups = g_gui_wakeups;
+    stat->tick_wakeups = g_tick_wakeups;
+    stat->sleep_ms = g_sleep_ms;
+    stat->wake_latency_us = g_wake_latency_us;
+
+    g_stat_start_us = now;
+    g_gui_wakeups = 0;
+    g_tick_wakeups = 0;
+    g_sleep_ms = 0;
+}
+
+#if LV_PORT_INDEV_EVENT_DRIVEN
+// 关闭背光和屏幕，停止 LVGL tick，GUI任务阻塞到按键通知
+// 屏幕睡眠时保留显存，LVGL 的时间也停止，唤醒后不需要重绘
+static void gui_idle_sleep(void)
+{
+    DISPLAY_PRINTF("Idle, display sleep\n");
+
+    uint16_t backlight = HAL::Backlight_GetVal();
+    HAL::Backlight_SetVal(0);
+    HAL::Display_SetSleep(true);
+    esp_timer_stop(g_tick_timer);
+
+    int64_t sleep_start = esp_timer_get_time();
+
+    uint32_t notify = 0;
+    while (!(notify & LV_PORT_NOTIFY_INDEV))
+    {
+        xTaskNotifyWait(0, UINT32_MAX, &notify, portMAX_DELAY);
+    }
+
+    HAL::Display_SetSleep(false);
+    HAL::Backlight_SetVal(backlight);
+    esp_timer_start_periodic(g_tick_timer, 1 * 1000);
+
+    // 唤醒的按键只用于点亮屏幕
+    uint32_t key_us = 0;
+    key_event_t event;
+    while (HAL::Button_GetEvent(&event))
+    {
+        if (key_us == 0)
+        {
+            key_us = event.time_us;
+        }
+    }
+
+    int64_t now = esp_timer_get_time();
+    g_sleep_ms += (uint32_t)((now - sleep_start) / 1000);
+    g_wake_latency_us = key_us ? ((uint32_t)now - key_us) : 0;
+
+    DISPLAY_PRINTF("Wake up in %lu us\n", g_wake_latency_us);
+    if (g_wake_latency_us > IDLE_WAKE_BUDGET_US)
+    {
+        DISPLAY_PRINTF("Wake up latency over budget(%d us)\n", IDLE_WAKE_BUDGET_US);
+    }
+}
+#endif
+
 // LVGL任务处理函数
 static void gui_task(void *args)
 {
     DISPLAY_PRINTF("Start LVGL Task\n");
 
+    uint32_t sleep_ms = 5;
+
     while (1)
     {
+        // 睡眠到下一个LVGL定时器到期，按键通知会立即唤醒
+        uint32_t notify = 0;
+        xTaskNotifyWait(0, UINT32_MAX, &notify, pdMS_TO_TICKS(sleep_ms));
+        g_gui_wakeups++;
+
+#if LV_PORT_INDEV_EVENT_DRIVEN
+        bool is_idle = false;
+#endif
+
         // 使用超时来防止死锁
         if (xSemaphoreTake(xGuiSemaphore, pdMS_TO_TICKS(100)) == pdTRUE)
         {
-            lv_task_handler();
+            uint32_t input_us = 0;
+
+#if LV_PORT_INDEV_EVENT_DRIVEN
+            if (notify & LV_PORT_NOTIFY_INDEV)
+            {
+                input_us = lv_port_indev_read();
+            }
+
+            if (input_us != 0)
+            {
+                // 不等刷新周期，按键的结果在本次处理中就刷新到屏幕
+                g_frame_done_us = 0;
+                lv_timer_ready(_lv_disp_get_refr_timer(NULL));
+            }
+#endif
+
+            uint32_t next_ms = lv_task_handler();
             // ui_tick();
+
+            // 本次处理中发送了一帧，记录按键到屏幕的延时
+            if (input_us != 0 && g_frame_done_us != 0)
+            {
+                g_input_latency_last_us = g_frame_done_us - input_us;
+                if (g_input_latency_last_us > g_input_latency_max_us)
+                {
+                    g_input_latency_max_us = g_input_latency_last_us;
+                }
+            }
+
+#if LV_PORT_INDEV_EVENT_DRIVEN
+            // 睡眠后只有按键通知能唤醒，轮询模式下不进入
+            is_idle = g_idle_timeout_ms != 0 && lv_disp_get_inactive_time(NULL) >= g_idle_timeout_ms;
+#endif
+
             xSemaphoreGive(xGuiSemaphore);
+
+            sleep_ms = (next_ms > GUI_TASK_SLEEP_MAX) ? GUI_TASK_SLEEP_MAX : next_ms;
+        }
+        else if (notify != 0)
+        {
+            // 没拿到锁，通知位已被清除，重新置位留到下一轮处理，
+            // 否则输入设备定时器暂停时队列中的按键会一直得不到读取
+            lv_port_gui_notify(notify);
+        }
+
+#if LV_PORT_INDEV_EVENT_DRIVEN
+        if (is_idle)
+        {
+            gui_idle_sleep();
+
+            if (xSemaphoreTake(xGuiSemaphore, pdMS_TO_TICKS(100)) == pdTRUE)
+            {
+                lv_disp_trig_activity(NULL);
+                xSemaphoreGive(xGuiSemaphore);
+            }
+            sleep_ms = 0;
+        }
+#endif
+
+        if (sleep_ms == 0)
+        {
+            taskYIELD();
         }
-        vTaskDelay(pdMS_TO_TICKS(5));
-        taskYIELD();
     }
 }
 
@@ -53,6 +252,7 @@ static void lv_tick_task(void *arg)
 {
     (void)arg;
     lv_tick_inc(1);
+    g_tick_wakeups++;
 }
 
 void lv_port_disp_init()
@@ -77,6 +277,9 @@ void lv_port_disp_init()
     disp_drv.ver_res = CONFIG_SCREEN_VER_RES;
     // 设置回调函数
     disp_drv.flush_cb = disp_flush_cb;
+#if LV_PORT_LATENCY_TRACE
+    disp_drv.rounder_cb = disp_rounder_cb;
+#endif
     // disp_drv.wait_cb = disp_wait_cb;
     disp_drv.draw_buf = &disp_buf;
 
@@ -91,9 +294,9 @@ void lv_port_disp_init()
         .name = "periodic_gui",
         .skip_unhandled_events = true};
 
-    esp_timer_handle_t lv_periodic_timer;
-    ESP_ERROR_CHECK(esp_timer_create(&lv_periodic_timer_args, &lv_periodic_timer));
-    ESP_ERROR_CHECK(esp_timer_start_periodic(lv_periodic_timer, 1 * 1000));
+    ESP_ERROR_CHECK(esp_timer_create(&lv_periodic_timer_args, &g_tick_timer));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(g_tick_timer, 1 * 1000));
+    g_stat_start_us = esp_timer_get_time();
     // 创建互斥信号量
     xGuiSemaphore = xSemaphoreCreateMutex();
     if (!xGuiSemaphore)
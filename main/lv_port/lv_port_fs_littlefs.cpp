@@ -0,0 +1,301 @@
+#include "lv_port.h"
+#include "../HAL/inc/HAL.h"
+#include "esp_littlefs.h"
+#include "esp_heap_caps.h"
+#include "esp_partition.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+
+#define FS_LITTLEFS_BASE_PATH  "/webfs"
+#define FS_LITTLEFS_PATH_MAX   (sizeof(FS_LITTLEFS_BASE_PATH) + CONFIG_LITTLEFS_OBJ_NAME_LEN + 1)
+#define FS_READ_AHEAD_SIZE     2048 // 预读块大小，文件内按此大小对齐 [byte]
+
+typedef struct
+{
+    int fd;
+    uint32_t pos;       // LVGL 看到的读写位置
+    uint32_t fd_pos;    // fd 的实际位置，相同时不再 lseek
+    uint32_t cache_pos; // 预读块在文件中的起始位置，按 FS_READ_AHEAD_SIZE 对齐
+    uint32_t cache_len; // 预读块中的有效长度，0 = 无效
+    uint8_t cache[FS_READ_AHEAD_SIZE] __attribute__((aligned(4)));
+} fs_file_t;
+
+static lv_fs_drv_t g_fs_drv;
+static const char *g_fs_label = NULL; // 挂载的分区名
+
+static bool fs_path_make(char *dst, const char *path)
+{
+    int len = snprintf(dst, FS_LITTLEFS_PATH_MAX, FS_LITTLEFS_BASE_PATH "%s%s",
+                       (path[0] == '/') ? "" : "/", path);
+    return len > 0 && len < (int)FS_LITTLEFS_PATH_MAX;
+}
+
+static bool fs_seek_fd(fs_file_t *f, uint32_t pos)
+{
+    if (f->fd_pos == pos)
+    {
+        return true;
+    }
+    if (lseek(f->fd, pos, SEEK_SET) < 0)
+    {
+        return false;
+    }
+    f->fd_pos = pos;
+    return true;
+}
+
+static bool fs_ready_cb(lv_fs_drv_t *drv)
+{
+    return esp_littlefs_mounted(g_fs_label);
+}
+
+static void *fs_open_cb(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode)
+{
+    char real_path[FS_LITTLEFS_PATH_MAX];
+    if (!fs_path_make(real_path, path))
+    {
+        return NULL;
+    }
+
+    int flags = 0;
+    if (mode == LV_FS_MODE_WR)
+        flags = O_WRONLY | O_CREAT;
+    else if (mode == LV_FS_MODE_RD)
+        flags = O_RDONLY;
+    else if (mode == (LV_FS_MODE_WR | LV_FS_MODE_RD))
+        flags = O_RDWR | O_CREAT;
+
+    // 预读块放在可 DMA 的内部 RAM，解码器可以直接从这里取数据
+    fs_file_t *f = (fs_file_t *)heap_caps_aligned_alloc(4, sizeof(fs_file_t), MALLOC_CAP_DMA);
+    if (f == NULL)
+    {
+        return NULL;
+    }
+
+    f->fd = open(real_path, flags, 0666);
+    if (f->fd < 0)
+    {
+        heap_caps_free(f);
+        return NULL;
+    }
+
+    f->pos = 0;
+    f->fd_pos = 0;
+    f->cache_pos = 0;
+    f->cache_len = 0;
+    return f;
+}
+
+static lv_fs_res_t fs_close_cb(lv_fs_drv_t *drv, void *file_p)
+{
+    fs_file_t *f = (fs_file_t *)file_p;
+    int ret = close(f->fd);
+    heap_caps_free(f);
+    return (ret == 0) ? LV_FS_RES_OK : LV_FS_RES_UNKNOWN;
+}
+
+static lv_fs_res_t fs_read_cb(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br)
+{
+    fs_file_t *f = (fs_file_t *)file_p;
+    uint8_t *dst = (uint8_t *)buf;
+    *br = 0;
+
+    while (btr > 0)
+    {
+        // 命中预读块
+        if (f->pos >= f->cache_pos && f->pos < f->cache_pos + f->cache_len)
+        {
+            uint32_t n = LV_MIN(btr, f->cache_pos + f->cache_len - f->pos);
+            memcpy(dst, f->cache + (f->pos - f->cache_pos), n);
+            dst += n;
+            btr -= n;
+            f->pos += n;
+            *br += n;
+            continue;
+        }
+
+        if (!fs_seek_fd(f, (btr >= FS_READ_AHEAD_SIZE) ? f->pos : (f->pos & ~(FS_READ_AHEAD_SIZE - 1))))
+        {
+            return LV_FS_RES_UNKNOWN;
+        }
+
+        // 大块数据直接读入调用者的缓冲区，不经过预读块
+        if (btr >= FS_READ_AHEAD_SIZE)
+        {
+            ssize_t n = read(f->fd, dst, btr);
+            if (n < 0)
+            {
+                return LV_FS_RES_UNKNOWN;
+            }
+            f->fd_pos += n;
+            f->pos += n;
+            *br += n;
+            break;
+        }
+
+        // 从对齐位置预读一整块，之后的小块读取都不再访问 flash
+        ssize_t n = read(f->fd, f->cache, FS_READ_AHEAD_SIZE);
+        if (n < 0)
+        {
+            f->cache_len = 0;
+            return LV_FS_RES_UNKNOWN;
+        }
+        f->cache_pos = f->fd_pos;
+        f->cache_len = n;
+        f->fd_pos += n;
+
+        if (f->pos >= f->cache_pos + f->cache_len)
+        {
+            // 已到文件末尾
+            break;
+        }
+    }
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_write_cb(lv_fs_drv_t *drv, void *file_p, const void *buf, uint32_t btw, uint32_t *bw)
+{
+    fs_file_t *f = (fs_file_t *)file_p;
+    *bw = 0;
+
+    if (!fs_seek_fd(f, f->pos))
+    {
+        return LV_FS_RES_UNKNOWN;
+    }
+
+    ssize_t n = write(f->fd, buf, btw);
+    if (n < 0)
+    {
+        return LV_FS_RES_UNKNOWN;
+    }
+
+    // 写入的内容可能在预读块中
+    f->cache_len = 0;
+    f->fd_pos += n;
+    f->pos += n;
+    *bw = n;
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_seek_cb(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    fs_file_t *f = (fs_file_t *)file_p;
+
+    switch (whence)
+    {
+    case LV_FS_SEEK_SET:
+        f->pos = pos;
+        break;
+    case LV_FS_SEEK_CUR:
+        f->pos += pos;
+        break;
+    case LV_FS_SEEK_END:
+    {
+        off_t end = lseek(f->fd, 0, SEEK_END);
+        if (end < 0)
+        {
+            return LV_FS_RES_UNKNOWN;
+        }
+        f->fd_pos = end;
+        f->pos = end + pos;
+        break;
+    }
+    default:
+        return LV_FS_RES_INV_PARAM;
+    }
+
+    // 只记录位置，读取时再 lseek，预读块中的跳转不访问 flash
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_tell_cb(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p)
+{
+    *pos_p = ((fs_file_t *)file_p)->pos;
+    return LV_FS_RES_OK;
+}
+
+static void *fs_dir_open_cb(lv_fs_drv_t *drv, const char *path)
+{
+    char real_path[FS_LITTLEFS_PATH_MAX];
+    if (!fs_path_make(real_path, path))
+    {
+        return NULL;
+    }
+    return opendir(real_path);
+}
+
+static lv_fs_res_t fs_dir_read_cb(lv_fs_drv_t *drv, void *rddir_p, char *fn)
+{
+    struct dirent *entry = readdir((DIR *)rddir_p);
+    if (entry == NULL)
+    {
+        // 读取结束
+        fn[0] = '\0';
+        return LV_FS_RES_OK;
+    }
+
+    // LVGL 约定目录名以 '/' 开头
+    if (entry->d_type == DT_DIR)
+    {
+        fn[0] = '/';
+        strcpy(&fn[1], entry->d_name);
+    }
+    else
+    {
+        strcpy(fn, entry->d_name);
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_dir_close_cb(lv_fs_drv_t *drv, void *rddir_p)
+{
+    return (closedir((DIR *)rddir_p) == 0) ? LV_FS_RES_OK : LV_FS_RES_UNKNOWN;
+}
+
+void lv_port_fs_littlefs_init(void)
+{
+    // partitions.csv 中为 webfs，partitions_ota.csv 中为 littlefs，使用第一个 littlefs 分区
+    const esp_partition_t *partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_LITTLEFS, NULL);
+    if (partition == NULL)
+    {
+        FS_PRINTF("LittleFS partition not found\n");
+        return;
+    }
+    g_fs_label = partition->label;
+
+    esp_vfs_littlefs_conf_t conf = {};
+    conf.base_path = FS_LITTLEFS_BASE_PATH;
+    conf.partition_label = g_fs_label;
+    // 分区中是烧录的资源文件，挂载失败时不格式化
+    conf.format_if_mount_failed = false;
+
+    esp_err_t err = esp_vfs_littlefs_register(&conf);
+    if (err != ESP_OK)
+    {
+        FS_PRINTF("LittleFS(%s) mount failed: %s\n", g_fs_label, esp_err_to_name(err));
+        return;
+    }
+
+    size_t total = 0, used = 0;
+    esp_littlefs_info(g_fs_label, &total, &used);
+    FS_PRINTF("LittleFS(%s) mounted, used %u / %u bytes\n", g_fs_label, (unsigned)used, (unsigned)total);
+
+    lv_fs_drv_init(&g_fs_drv);
+    g_fs_drv.letter = LV_PORT_FS_LITTLEFS_LETTER;
+    // 使用自己的对齐预读块，不再使用 LVGL 的缓存
+    g_fs_drv.cache_size = 0;
+    g_fs_drv.ready_cb = fs_ready_cb;
+    g_fs_drv.open_cb = fs_open_cb;
+    g_fs_drv.close_cb = fs_close_cb;
+    g_fs_drv.read_cb = fs_read_cb;
+    g_fs_drv.write_cb = fs_write_cb;
+    g_fs_drv.seek_cb = fs_seek_cb;
+    g_fs_drv.tell_cb = fs_tell_cb;
+    g_fs_drv.dir_open_cb = fs_dir_open_cb;
+    g_fs_drv.dir_read_cb = fs_dir_read_cb;
+    g_fs_drv.dir_close_cb = fs_dir_close_cb;
+    lv_fs_drv_register(&g_fs_drv);
+}
@@ -1,9 +1,414 @@
 #include "lv_port.h"
 #include "../HAL/inc/HAL.h"
+#include "esp_heap_caps.h"
+#include "freertos/queue.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <sys/stat.h>
+
+#if CONFIG_SD_ENABLE
+
+#define SD_PATH_MAX        64
+#define SD_STREAM_BUF_SIZE 4096 // 每个缓冲区的大小，按扇区对齐时 FATFS 直接 DMA 到缓冲区 [byte]
+#define SD_STREAM_QUEUE    8    // 等待预读的文件数
+
+/* 双缓冲顺序读取: 解码器读取前台缓冲区时，后台任务把下一块读入另一个缓冲区，
+ * 图片按行解码、地图瓦片按块读取时都只需要两个缓冲区，不需要把整个文件读入 RAM
+ */
+typedef struct
+{
+    int fd;
+    uint32_t mount_id;  // 打开时的挂载编号，卡被拔出后失效
+    uint32_t pos;       // LVGL 看到的读写位置
+    uint32_t fd_pos;    // fd 的实际位置
+    uint32_t size;
+
+    uint8_t *buf[2];
+    uint32_t buf_pos[2]; // 缓冲区在文件中的起始位置
+    int32_t buf_len[2];  // 缓冲区中的有效长度，0 = 无效
+    uint8_t front;       // 正在读取的缓冲区，另一个由后台任务预读
+
+    bool loading;        // 后台缓冲区正在预读
+    SemaphoreHandle_t done;
+} sd_file_t;
+
+static lv_fs_drv_t g_fs_drv;
+static QueueHandle_t g_stream_queue = NULL;
+
+static bool sd_path_make(char *dst, const char *path)
+{
+    int len = snprintf(dst, SD_PATH_MAX, CONFIG_SD_MOUNT_POINT "%s%s",
+                       (path[0] == '/') ? "" : "/", path);
+    return len > 0 && len < SD_PATH_MAX;
+}
+
+// 读取一块到缓冲区，调用前需要持有 SD 锁
+static int32_t sd_load_locked(sd_file_t *f, uint8_t *buf, uint32_t pos, uint32_t len)
+{
+    if (f->fd_pos != pos)
+    {
+        if (lseek(f->fd, pos, SEEK_SET) < 0)
+        {
+            return -1;
+        }
+        f->fd_pos = pos;
+    }
+
+    ssize_t n = read(f->fd, buf, len);
+    if (n > 0)
+    {
+        f->fd_pos += n;
+    }
+    return n;
+}
+
+static int32_t sd_load(sd_file_t *f, uint8_t *buf, uint32_t pos, uint32_t len)
+{
+    int32_t n = -1;
+    if (HAL::SD_Lock() == f->mount_id)
+    {
+        n = sd_load_locked(f, buf, pos, len);
+    }
+    HAL::SD_Unlock();
+    return n;
+}
+
+// 后台预读任务，在另一个核心上运行，与解码和刷屏并行
+static void sd_stream_task(void *arg)
+{
+    sd_file_t *f;
+
+    while (1)
+    {
+        xQueueReceive(g_stream_queue, &f, portMAX_DELAY);
+
+        uint8_t back = !f->front;
+        int32_t n = sd_load(f, f->buf[back], f->buf_pos[back], SD_STREAM_BUF_SIZE);
+        f->buf_len[back] = (n > 0) ? n : 0;
+
+        xSemaphoreGive(f->done);
+    }
+}
+
+// 等待后台预读结束，之后可以访问 fd 和后台缓冲区
+static void sd_stream_wait(sd_file_t *f)
+{
+    if (f->loading)
+    {
+        xSemaphoreTake(f->done, portMAX_DELAY);
+        f->loading = false;
+    }
+}
+
+// 开始预读前台缓冲区之后的一块
+static void sd_stream_prefetch(sd_file_t *f)
+{
+    uint8_t back = !f->front;
+    uint32_t pos = f->buf_pos[f->front] + f->buf_len[f->front];
+
+    if (f->loading || pos >= f->size || f->buf_len[f->front] < SD_STREAM_BUF_SIZE)
+    {
+        return;
+    }
+    if (f->buf_len[back] > 0 && f->buf_pos[back] == pos)
+    {
+        return;
+    }
+
+    f->buf_pos[back] = pos;
+    f->buf_len[back] = 0;
+    f->loading = true;
+    if (xQueueSend(g_stream_queue, &f, 0) != pdTRUE)
+    {
+        // 队列满时放弃预读，读取时再同步读入
+        f->loading = false;
+    }
+}
+
+static bool sd_stream_hit(sd_file_t *f, uint8_t index)
+{
+    return f->buf_len[index] > 0 && f->pos >= f->buf_pos[index] && f->pos < f->buf_pos[index] + f->buf_len[index];
+}
+
+static bool fs_ready_cb(lv_fs_drv_t *drv)
+{
+    return HAL::SD_GetReady();
+}
+
+static void *fs_open_cb(lv_fs_drv_t *drv, const char *path, lv_fs_mode_t mode)
+{
+    char real_path[SD_PATH_MAX];
+    if (!sd_path_make(real_path, path))
+    {
+        return NULL;
+    }
+
+    int flags = 0;
+    if (mode == LV_FS_MODE_WR)
+        flags = O_WRONLY | O_CREAT;
+    else if (mode == LV_FS_MODE_RD)
+        flags = O_RDONLY;
+    else if (mode == (LV_FS_MODE_WR | LV_FS_MODE_RD))
+        flags = O_RDWR | O_CREAT;
+
+    sd_file_t *f = (sd_file_t *)lv_mem_alloc(sizeof(sd_file_t));
+    if (f == NULL)
+    {
+        return NULL;
+    }
+    memset(f, 0, sizeof(sd_file_t));
+
+    // 双缓冲放在可 DMA 的内部 RAM，扇区对齐的读取不经过 FATFS 的中转缓冲区
+    f->buf[0] = (uint8_t *)heap_caps_aligned_alloc(4, SD_STREAM_BUF_SIZE, MALLOC_CAP_DMA);
+    f->buf[1] = (uint8_t *)heap_caps_aligned_alloc(4, SD_STREAM_BUF_SIZE, MALLOC_CAP_DMA);
+    f->done = xSemaphoreCreateBinary();
+    f->fd = -1;
+
+    if (f->buf[0] && f->buf[1] && f->done)
+    {
+        f->mount_id = HAL::SD_Lock();
+        if (f->mount_id != 0)
+        {
+            f->fd = open(real_path, flags, 0666);
+            struct stat st;
+            if (f->fd >= 0 && fstat(f->fd, &st) == 0)
+            {
+                f->size = st.st_size;
+            }
+        }
+        HAL::SD_Unlock();
+    }
+
+    if (f->fd < 0)
+    {
+        heap_caps_free(f->buf[0]);
+        heap_caps_free(f->buf[1]);
+        if (f->done)
+        {
+            vSemaphoreDelete(f->done);
+        }
+        lv_mem_free(f);
+        return NULL;
+    }
+
+    return f;
+}
+
+static lv_fs_res_t fs_close_cb(lv_fs_drv_t *drv, void *file_p)
+{
+    sd_file_t *f = (sd_file_t *)file_p;
+    sd_stream_wait(f);
+
+    // 卡被拔出后句柄已随卸载关闭
+    if (HAL::SD_Lock() == f->mount_id)
+    {
+        close(f->fd);
+    }
+    HAL::SD_Unlock();
+
+    heap_caps_free(f->buf[0]);
+    heap_caps_free(f->buf[1]);
+    vSemaphoreDelete(f->done);
+    lv_mem_free(f);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_read_cb(lv_fs_drv_t *drv, void *file_p, void *buf, uint32_t btr, uint32_t *br)
+{
+    sd_file_t *f = (sd_file_t *)file_p;
+    uint8_t *dst = (uint8_t *)buf;
+    *br = 0;
+
+    while (btr > 0 && f->pos < f->size)
+    {
+        uint8_t front = f->front;
+
+        // 命中前台缓冲区
+        if (sd_stream_hit(f, front))
+        {
+            uint32_t n = LV_MIN(btr, f->buf_pos[front] + f->buf_len[front] - f->pos);
+            memcpy(dst, f->buf[front] + (f->pos - f->buf_pos[front]), n);
+            dst += n;
+            btr -= n;
+            f->pos += n;
+            *br += n;
+            continue;
+        }
+
+        // 顺序读到了后台缓冲区，交换后继续预读下一块
+        sd_stream_wait(f);
+        if (sd_stream_hit(f, !front))
+        {
+            f->front = !front;
+            sd_stream_prefetch(f);
+            continue;
+        }
+
+        // 大块数据直接读入调用者的缓冲区
+        if (btr >= SD_STREAM_BUF_SIZE)
+        {
+            int32_t n = sd_load(f, dst, f->pos, btr);
+            if (n < 0)
+            {
+                return LV_FS_RES_HW_ERR;
+            }
+            f->pos += n;
+            *br += n;
+            break;
+        }
+
+        // 跳转到了缓冲区之外，从对齐位置同步读入前台缓冲区
+        uint32_t pos = f->pos & ~(SD_STREAM_BUF_SIZE - 1);
+        int32_t n = sd_load(f, f->buf[front], pos, SD_STREAM_BUF_SIZE);
+        if (n < 0)
+        {
+            f->buf_len[front] = 0;
+            return LV_FS_RES_HW_ERR;
+        }
+        f->buf_pos[front] = pos;
+        f->buf_len[front] = n;
+        if (!sd_stream_hit(f, front))
+        {
+            break;
+        }
+        sd_stream_prefetch(f);
+    }
+
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_write_cb(lv_fs_drv_t *drv, void *file_p, const void *buf, uint32_t btw, uint32_t *bw)
+{
+    sd_file_t *f = (sd_file_t *)file_p;
+    lv_fs_res_t res = LV_FS_RES_HW_ERR;
+    *bw = 0;
+
+    sd_stream_wait(f);
+
+    if (HAL::SD_Lock() == f->mount_id
+            && (f->fd_pos == f->pos || lseek(f->fd, f->pos, SEEK_SET) >= 0))
+    {
+        f->fd_pos = f->pos;
+        ssize_t n = write(f->fd, buf, btw);
+        if (n >= 0)
+        {
+            f->fd_pos += n;
+            f->pos += n;
+            f->size = LV_MAX(f->size, f->pos);
+            *bw = n;
+            res = LV_FS_RES_OK;
+        }
+    }
+    HAL::SD_Unlock();
+
+    // 写入的内容可能在缓冲区中
+    f->buf_len[0] = 0;
+    f->buf_len[1] = 0;
+    return res;
+}
+
+static lv_fs_res_t fs_seek_cb(lv_fs_drv_t *drv, void *file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    sd_file_t *f = (sd_file_t *)file_p;
+
+    // 只记录位置，在缓冲区内跳转时不访问 SD 卡
+    switch (whence)
+    {
+    case LV_FS_SEEK_SET:
+        f->pos = pos;
+        break;
+    case LV_FS_SEEK_CUR:
+        f->pos += pos;
+        break;
+    case LV_FS_SEEK_END:
+        f->pos = f->size + pos;
+        break;
+    default:
+        return LV_FS_RES_INV_PARAM;
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_tell_cb(lv_fs_drv_t *drv, void *file_p, uint32_t *pos_p)
+{
+    *pos_p = ((sd_file_t *)file_p)->pos;
+    return LV_FS_RES_OK;
+}
+
+static void *fs_dir_open_cb(lv_fs_drv_t *drv, const char *path)
+{
+    char real_path[SD_PATH_MAX];
+    if (!sd_path_make(real_path, path) || !HAL::SD_GetReady())
+    {
+        return NULL;
+    }
+    return opendir(real_path);
+}
+
+static lv_fs_res_t fs_dir_read_cb(lv_fs_drv_t *drv, void *rddir_p, char *fn)
+{
+    struct dirent *entry = readdir((DIR *)rddir_p);
+    if (entry == NULL)
+    {
+        // 读取结束
+        fn[0] = '\0';
+        return LV_FS_RES_OK;
+    }
+
+    // LVGL 约定目录名以 '/' 开头
+    if (entry->d_type == DT_DIR)
+    {
+        fn[0] = '/';
+        strcpy(&fn[1], entry->d_name);
+    }
+    else
+    {
+        strcpy(fn, entry->d_name);
+    }
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t fs_dir_close_cb(lv_fs_drv_t *drv, void *rddir_p)
+{
+    return (closedir((DIR *)rddir_p) == 0) ? LV_FS_RES_OK : LV_FS_RES_UNKNOWN;
+}
+
+void lv_port_fs_sdfat_init(void)
+{
+    g_stream_queue = xQueueCreate(SD_STREAM_QUEUE, sizeof(sd_file_t *));
+    // 比GUI任务优先级高，放在另一个核心上
+    xTaskCreatePinnedToCore(sd_stream_task, "sd_stream", 3 * 1024, NULL, 4, NULL, 0);
+
+    lv_fs_drv_init(&g_fs_drv);
+    g_fs_drv.letter = LV_PORT_FS_SD_LETTER;
+    // 使用自己的双缓冲，不再使用 LVGL 的缓存
+    g_fs_drv.cache_size = 0;
+    g_fs_drv.ready_cb = fs_ready_cb;
+    g_fs_drv.open_cb = fs_open_cb;
+    g_fs_drv.close_cb = fs_close_cb;
+    g_fs_drv.read_cb = fs_read_cb;
+    g_fs_drv.write_cb = fs_write_cb;
+    g_fs_drv.seek_cb = fs_seek_cb;
+    g_fs_drv.tell_cb = fs_tell_cb;
+    g_fs_drv.dir_open_cb = fs_dir_open_cb;
+    g_fs_drv.dir_read_cb = fs_dir_read_cb;
+    g_fs_drv.dir_close_cb = fs_dir_close_cb;
+    lv_fs_drv_register(&g_fs_drv);
+}
+
+#else
+
+void lv_port_fs_sdfat_init(void)
+{
+    // 未使用 SD 卡：不创建预读任务，也不注册驱动，"S:" 路径打开失败
+}
+
+#endif
 
-// 这里简单实现，暂时不添加文件系统支持
 void lv_port_fs_init(void)
 {
     DISPLAY_PRINTF("LVGL文件系统接口初始化\n");
-    // 未来可以在这里添加SD卡等文件系统支持
-}
\ No newline at end of file
+    lv_port_fs_littlefs_init();
+    lv_port_fs_sdfat_init();
+}
@@ -6,53 +6,105 @@
 static lv_group_t *g_input_group;  // 输入组
 static lv_indev_t *g_keypad_indev; // 按键输入设备
 
+static uint32_t g_key_time_us = 0;    // 本次读取送出的第一个按键的时间
+static bool g_key_drained = false;    // 本次读取已取空按键队列
+
+
+// 按键动作对应的 LVGL 键值，0 表示不产生按键
+static uint32_t keypad_action_to_key(key_action_t action)
+{
+    switch (action) {
+        case KEY_ACTION_SINGLE_CLICK:
+            return LV_KEY_ENTER;
+        case KEY_ACTION_DOUBLE_CLICK:
+            // 双击 - 移动到下一个组件
+            return LV_KEY_NEXT;
+        case KEY_ACTION_TRIPLE_CLICK:
+            // 三击 - 切换页面
+        default:
+            return 0;
+    }
+}
 
 // 按键输入处理函数
+// 每个按键事件产生一次按下和一次释放，通过 continue_reading 在同一次读取中
+// 处理完队列里的所有事件，连续的点击不会互相覆盖
 static void keypad_read(lv_indev_drv_t *drv, lv_indev_data_t *data)
 {
     static uint32_t last_key = 0;
     static bool key_pressed = false;
-    
-    // 获取按键动作
-    key_action_t action = HAL::Button_GetAction();
-    
-    // 根据按键动作执行不同操作
-    if (action != KEY_ACTION_NONE) {
-        
-        // 处理不同类型的按键动作
-        switch (action) {
-            case KEY_ACTION_NONE:
-                break;
-            case KEY_ACTION_SINGLE_CLICK:
-                last_key = LV_KEY_ENTER;
-                key_pressed = true;
-                break;
-                
-            case KEY_ACTION_DOUBLE_CLICK:
-                // 双击 - 移动到下一个组件
-                last_key = LV_KEY_NEXT;
-                key_pressed = true;
-                break;
-                
-            case KEY_ACTION_TRIPLE_CLICK:
-                // 三击 - 切换页面
-                break;
-        }
-    } else {
-        // 没有新的按键动作，释放按键
-        if (key_pressed) {
-            key_pressed = false;
+
+    if (key_pressed) {
+        // 上次报告了按下，这次报告释放
+        key_pressed = false;
+        data->state = LV_INDEV_STATE_RELEASED;
+        data->key = last_key;
+        data->continue_reading = true;
+        return;
+    }
+
+    // 取出下一个会产生按键的事件
+    key_event_t event;
+    while (HAL::Button_GetEvent(&event)) {
+        uint32_t key = keypad_action_to_key(event.action);
+        if (key != 0) {
+            if (g_key_time_us == 0) {
+                g_key_time_us = event.time_us;
+#if LV_PORT_LATENCY_TRACE
+                lv_port_latency_begin(event.down_us, event.time_us);
+#endif
+            }
+            last_key = key;
+            key_pressed = true;
+            data->state = LV_INDEV_STATE_PRESSED;
+            data->key = last_key;
+            data->continue_reading = true;
+            return;
         }
     }
-    
-    // 设置按键状态
-    data->state = key_pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+
+    data->state = LV_INDEV_STATE_RELEASED;
     data->key = last_key;
-    
-    // 释放按键后重置按键值
-    if (data->state == LV_INDEV_STATE_RELEASED) {
-        last_key = 0;
+    data->continue_reading = false;
+
+#if LV_PORT_INDEV_EVENT_DRIVEN
+    // 队列已空，等待下一次按键通知
+    g_key_drained = true;
+    lv_timer_pause(drv->read_timer);
+#endif
+}
+
+#if LV_PORT_LATENCY_TRACE
+// LVGL 向控件派发由输入设备产生的事件
+static void keypad_feedback_cb(lv_indev_drv_t *drv, uint8_t code)
+{
+    lv_port_latency_mark(LV_PORT_LATENCY_EVENT);
+}
+#endif
+
+#if LV_PORT_INDEV_EVENT_DRIVEN
+// 按键回调中调用，唤醒GUI任务读取输入设备
+static void keypad_event_notify(void)
+{
+    lv_port_gui_notify(LV_PORT_NOTIFY_INDEV);
+}
+#endif
+
+// 在GUI任务中调用，立即处理队列中的按键
+uint32_t lv_port_indev_read(void)
+{
+    lv_timer_t *timer = g_keypad_indev->driver->read_timer;
+
+    g_key_time_us = 0;
+    g_key_drained = false;
+    lv_indev_read_timer_cb(timer);
+
+    // 输入设备被禁用或屏幕动画中没有读取，恢复轮询直到队列取空
+    if (!g_key_drained) {
+        lv_timer_resume(timer);
     }
+
+    return g_key_time_us;
 }
 
 // 添加所有需要焦点控制的UI元素到组
@@ -68,17 +120,9 @@ void add_all_objs_to_group(lv_obj_t *parent, lv_group_t *group)
     for (uint32_t i = 0; i < child_cnt; i++) {
         lv_obj_t *child = lv_obj_get_child(parent, i);
         
-        // 检查是否是可聚焦控件类型
-        if (lv_obj_check_type(child, &lv_switch_class) ||   // Switch
-            lv_obj_check_type(child, &lv_btn_class) ||      // Button
-            lv_obj_check_type(child, &lv_slider_class) ||   // Slider
-            lv_obj_check_type(child, &lv_dropdown_class) || // Dropdown
-            lv_obj_check_type(child, &lv_roller_class) ||   // Roller
-            lv_obj_check_type(child, &lv_textarea_class)) { // TextArea
-            
-            // 添加到组
+        // 可聚焦控件的类(按钮、开关、滑块、下拉框、滚轮、文本框等)带有 group_def 标志
+        if (lv_obj_is_group_def(child)) {
             lv_group_add_obj(group, child);
-            printf("Added control to focus group\n");
         }
         
         // 递归处理子对象的子对象
@@ -98,8 +142,17 @@ void lv_port_indev_init(void)
     lv_indev_drv_init(&indev_drv);
     indev_drv.type = LV_INDEV_TYPE_KEYPAD;
     indev_drv.read_cb = keypad_read;
+#if LV_PORT_LATENCY_TRACE
+    indev_drv.feedback_cb = keypad_feedback_cb;
+#endif
     g_keypad_indev = lv_indev_drv_register(&indev_drv);
 
+#if LV_PORT_INDEV_EVENT_DRIVEN
+    // 不再周期轮询，由按键通知触发读取
+    lv_timer_pause(g_keypad_indev->driver->read_timer);
+    HAL::Button_SetEventCallback(keypad_event_notify);
+#endif
+
     // 将输入设备与组关联
     lv_indev_set_group(g_keypad_indev, g_input_group);
     
@@ -0,0 +1,102 @@
+#include "lv_port.h"
+#include "../HAL/inc/HAL.h"
+
+#if LV_PORT_LATENCY_TRACE
+#include <algorithm>
+
+#define LATENCY_SAMPLE_NUM    128 // 保留最近的样本数
+#define LATENCY_REPORT_PERIOD 32  // 每隔多少次按键自动打印一次
+#define LATENCY_NONE          UINT32_MAX
+
+// 当前按键各阶段的时间 [us]，0 表示还未到达
+static uint32_t g_trace[_LV_PORT_LATENCY_LAST];
+static bool g_trace_active = false;
+
+// 各阶段相对于按下的延时 [us]，LATENCY_NONE 表示该次按键没有经过此阶段
+static uint32_t g_samples[_LV_PORT_LATENCY_LAST][LATENCY_SAMPLE_NUM];
+static uint32_t g_sample_cnt = 0;
+
+static const char *const g_stage_name[_LV_PORT_LATENCY_LAST] = {
+    "down", "click", "read", "event", "invalidate", "flush", "done"};
+
+static uint32_t latency_now(void)
+{
+    return (uint32_t)esp_timer_get_time();
+}
+
+// 在 keypad_read 送出按键时调用，上一次按键如果没有刷新屏幕则被丢弃
+void lv_port_latency_begin(uint32_t down_us, uint32_t click_us)
+{
+    memset(g_trace, 0, sizeof(g_trace));
+    g_trace[LV_PORT_LATENCY_DOWN] = down_us ? down_us : click_us;
+    g_trace[LV_PORT_LATENCY_CLICK] = click_us;
+    g_trace[LV_PORT_LATENCY_READ] = latency_now();
+    g_trace_active = true;
+}
+
+void lv_port_latency_mark(lv_port_latency_stage_t stage)
+{
+    if (!g_trace_active || g_trace[stage] != 0)
+    {
+        return;
+    }
+
+    g_trace[stage] = latency_now();
+
+    if (stage != LV_PORT_LATENCY_DONE)
+    {
+        return;
+    }
+
+    // 按键产生的第一帧发送完毕，保存样本
+    uint32_t index = g_sample_cnt % LATENCY_SAMPLE_NUM;
+    for (int i = 0; i < _LV_PORT_LATENCY_LAST; i++)
+    {
+        g_samples[i][index] = g_trace[i] ? (g_trace[i] - g_trace[LV_PORT_LATENCY_DOWN]) : LATENCY_NONE;
+    }
+    g_sample_cnt++;
+    g_trace_active = false;
+
+    if (g_sample_cnt % LATENCY_REPORT_PERIOD == 0)
+    {
+        lv_port_latency_report();
+    }
+}
+
+void lv_port_latency_report(void)
+{
+    uint32_t num = std::min<uint32_t>(g_sample_cnt, LATENCY_SAMPLE_NUM);
+    static uint32_t sorted[LATENCY_SAMPLE_NUM];
+
+    LVGL_PRINTF("Input latency of the last %lu presses, from press down [us]\n", num);
+
+    for (int i = LV_PORT_LATENCY_CLICK; i < _LV_PORT_LATENCY_LAST; i++)
+    {
+        // 没有经过该阶段的样本不参与统计
+        uint32_t cnt = 0;
+        for (uint32_t j = 0; j < num; j++)
+        {
+            if (g_samples[i][j] != LATENCY_NONE)
+            {
+                sorted[cnt++] = g_samples[i][j];
+            }
+        }
+
+        if (cnt == 0)
+        {
+            LVGL_PRINTF("  %-10s -\n", g_stage_name[i]);
+            continue;
+        }
+
+        std::sort(sorted, sorted + cnt);
+        LVGL_PRINTF("  %-10s p50 %7lu p90 %7lu p99 %7lu max %7lu (%lu)\n",
+                    g_stage_name[i],
+                    sorted[cnt * 50 / 100],
+                    sorted[cnt * 90 / 100],
+                    sorted[cnt * 99 / 100],
+                    sorted[cnt - 1],
+                    cnt);
+    }
+}
+
+#endif
@@ -27,6 +27,9 @@ void setup(void)
     lv_init();
     lv_port_init();
 
+    /* 30s 无操作后屏幕睡眠，按键唤醒 */
+    lv_port_set_idle_timeout(30 * 1000);
+
     HAL::Backlight_SetGradually(2048, 1000);
 
     App_Init();
@@ -36,5 +39,7 @@ void setup(void)
 
 void loop()
 {
+    /* 检测SD卡插拔 */
+    HAL::SD_Update();
     delay(1000);
 }
@@ -0,0 +1,170 @@
+#include "AssetPack.h"
+#include "esp_partition.h"
+#include <string.h>
+#include <stdio.h>
+
+#define AssetPack_DEBUG
+#ifdef AssetPack_DEBUG
+#define ASSET_LOG_INFO(format, ...) printf("[AssetPack] [Info] " format, ##__VA_ARGS__)
+#define ASSET_LOG_WARN(format, ...) printf("[AssetPack] [Warn] " format, ##__VA_ARGS__)
+#else
+#define ASSET_LOG_INFO(...)
+#define ASSET_LOG_WARN(...)
+#endif
+
+static const AssetPack::Header_t* Pack_ = nullptr;
+static const AssetPack::Entry_t* Index_ = nullptr;
+static lv_img_dsc_t* ImageDsc_ = nullptr;
+
+/**
+  * @brief  Check that the index is sorted and every payload is inside the pack
+  * @param  pack: Pointer to the mapped pack
+  * @retval Return true if the pack can be used
+  */
+static bool CheckIndex(const AssetPack::Header_t* pack)
+{
+    const AssetPack::Entry_t* index = (const AssetPack::Entry_t*)(pack + 1);
+
+    if (sizeof(AssetPack::Header_t) + pack->count * sizeof(AssetPack::Entry_t) > pack->size)
+    {
+        return false;
+    }
+
+    for (uint32_t i = 0; i < pack->count; i++)
+    {
+        const AssetPack::Entry_t* entry = &index[i];
+
+        if (entry->name[ASSET_PACK_NAME_SIZE - 1] != '\0'
+                || entry->offset > pack->size
+                || entry->size > pack->size - entry->offset)
+        {
+            return false;
+        }
+
+        if (i > 0 && strcmp(index[i - 1].name, entry->name) >= 0)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+  * @brief  Map the asset partition into the data address space
+  * @param  label: Partition label
+  * @retval Return true if the pack is mapped and valid
+  */
+bool AssetPack::Init(const char* label)
+{
+    const esp_partition_t* partition = esp_partition_find_first(
+        ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, label);
+    if (partition == nullptr)
+    {
+        ASSET_LOG_WARN("partition(%s) was not found\r\n", label);
+        return false;
+    }
+
+    Header_t header;
+    if (esp_partition_read(partition, 0, &header, sizeof(header)) != ESP_OK
+            || header.magic != ASSET_PACK_MAGIC
+            || header.version != ASSET_PACK_VERSION
+            || header.size > partition->size)
+    {
+        ASSET_LOG_WARN("partition(%s) has no asset pack\r\n", label);
+        return false;
+    }
+
+    /* Pixels in another format would be drawn wrong */
+    if (header.colorDepth != LV_COLOR_DEPTH || header.colorSwap != LV_COLOR_16_SWAP)
+    {
+        ASSET_LOG_WARN(
+            "pack color format(%d, %d) does not match(%d, %d)\r\n",
+            header.colorDepth, header.colorSwap,
+            LV_COLOR_DEPTH, LV_COLOR_16_SWAP
+        );
+        return false;
+    }
+
+    /* Only the used part of the partition takes MMU pages */
+    const void* ptr;
+    esp_partition_mmap_handle_t handle;
+    if (esp_partition_mmap(partition, 0, header.size, ESP_PARTITION_MMAP_DATA, &ptr, &handle) != ESP_OK)
+    {
+        ASSET_LOG_WARN("partition(%s) mmap failed\r\n", label);
+        return false;
+    }
+
+    const Header_t* pack = (const Header_t*)ptr;
+    if (!CheckIndex(pack))
+    {
+        ASSET_LOG_WARN("partition(%s) index is corrupted\r\n", label);
+        esp_partition_munmap(handle);
+        return false;
+    }
+
+    /* The descriptors point into the mapping, the pixels are never copied */
+    lv_img_dsc_t* dsc = new lv_img_dsc_t[pack->count];
+    const Entry_t* index = (const Entry_t*)(pack + 1);
+
+    for (uint32_t i = 0; i < pack->count; i++)
+    {
+        dsc[i].header = index[i].header;
+        dsc[i].data_size = index[i].size;
+        dsc[i].data = (const uint8_t*)pack + index[i].offset;
+    }
+
+    Pack_ = pack;
+    Index_ = index;
+    ImageDsc_ = dsc;
+
+    ASSET_LOG_INFO("%ld images mapped at [0x%p], %ld bytes\r\n", pack->count, pack, pack->size);
+    return true;
+}
+
+/**
+  * @brief  Binary search the image in the sorted index
+  * @param  name: Image name
+  * @retval The image in the pack, nullptr if not found
+  */
+const lv_img_dsc_t* AssetPack::GetImage(const char* name)
+{
+    if (Pack_ == nullptr)
+    {
+        return nullptr;
+    }
+
+    int32_t low = 0;
+    int32_t high = (int32_t)Pack_->count - 1;
+
+    while (low <= high)
+    {
+        int32_t mid = (low + high) / 2;
+        int cmp = strncmp(name, Index_[mid].name, ASSET_PACK_NAME_SIZE);
+
+        if (cmp == 0)
+        {
+            return &ImageDsc_[mid];
+        }
+        else if (cmp < 0)
+        {
+            high = mid - 1;
+        }
+        else
+        {
+            low = mid + 1;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+  * @brief  Get the number of images in the pack
+  * @param  None
+  * @retval Number of images, 0 if no pack is mapped
+  */
+uint32_t AssetPack::GetCount()
+{
+    return (Pack_ != nullptr) ? Pack_->count : 0;
+}
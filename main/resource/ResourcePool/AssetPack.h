@@ -0,0 +1,39 @@
+#ifndef __ASSET_PACK_H
+#define __ASSET_PACK_H
+
+#include "lvgl.h"
+
+/* Packed images in a data partition, built by resource/tools/pack_assets.py */
+#define ASSET_PACK_MAGIC          0x4B415052 // "RPAK"
+#define ASSET_PACK_VERSION        1
+#define ASSET_PACK_NAME_SIZE      24
+#define ASSET_PACK_PARTITION      "assets"
+
+namespace AssetPack
+{
+
+typedef struct
+{
+    uint32_t magic;
+    uint16_t version;
+    uint8_t colorDepth;  // LV_COLOR_DEPTH of the pixels
+    uint8_t colorSwap;   // LV_COLOR_16_SWAP of the pixels
+    uint32_t count;      // Number of entries in the index
+    uint32_t size;       // Size of the pack, header included
+} Header_t;
+
+typedef struct
+{
+    char name[ASSET_PACK_NAME_SIZE]; // Sorted, zero padded
+    lv_img_header_t header;
+    uint32_t offset;                 // Offset of the pixels from the start of the pack
+    uint32_t size;
+} Entry_t;
+
+bool Init(const char* label = ASSET_PACK_PARTITION);
+const lv_img_dsc_t* GetImage(const char* name);
+uint32_t GetCount();
+
+}
+
+#endif
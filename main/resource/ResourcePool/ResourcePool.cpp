@@ -1,5 +1,13 @@
 #include "ResourcePool.h"
 #include "ResourceManager.h"
+#include "AssetPack.h"
+
+/* Link the images into the app as well, used when no asset pack is flashed.
+ * 0 = the images only come from the asset partition and are left out of the app
+ */
+#ifndef RESOURCE_POOL_BUILTIN_IMAGE
+#define RESOURCE_POOL_BUILTIN_IMAGE 1
+#endif
 
 static ResourceManager Font_;
 static ResourceManager Image_;
@@ -29,6 +37,7 @@ extern "C"
         IMPORT_FONT(bahnschrift_65);
         IMPORT_FONT(agencyb_36);
 
+#if RESOURCE_POOL_BUILTIN_IMAGE
         /* Import Images */
         IMPORT_IMG(battery);
         IMPORT_IMG(battery_info);
@@ -51,12 +60,14 @@ extern "C"
         IMPORT_IMG(system_info);
         IMPORT_IMG(time_info);
         IMPORT_IMG(trip);
+#endif
     }
 
 } /* extern "C" */
 
 void ResourcePool::Init()
 {
+    AssetPack::Init();
     Resource_Init();
     Font_.SetDefault((void *)LV_FONT_DEFAULT);
 }
@@ -67,5 +78,11 @@ lv_font_t *ResourcePool::GetFont(const char *name)
 }
 const void *ResourcePool::GetImage(const char *name)
 {
+    /* Images in the asset partition replace the linked ones */
+    const lv_img_dsc_t *img = AssetPack::GetImage(name);
+    if (img != nullptr)
+    {
+        return img;
+    }
     return Image_.GetResource(name);
 }
\ No newline at end of file
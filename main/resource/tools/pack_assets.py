@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""
+Pack LVGL images into the asset partition image read by AssetPack.
+
+Inputs are the LVGL image converter outputs: C arrays (img_src_<name>.c,
+the section matching the color depth is used) or binary files (<name>.bin,
+4 byte lv_img_header_t followed by the pixels).
+
+Layout (little endian):
+    header   magic "RPAK", version, color depth, color swap, count, size
+    index    count entries sorted by name: name[24], lv_img_header_t, offset, size
+    payloads aligned to ASSET_PACK_ALIGN, offsets from the start of the pack
+
+Flash with:
+    parttool.py write_partition --partition-name assets --input assets.bin
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+ASSET_PACK_MAGIC = 0x4B415052  # "RPAK"
+ASSET_PACK_VERSION = 1
+ASSET_PACK_ALIGN = 16
+ASSET_PACK_NAME_SIZE = 24
+
+HEADER_FMT = "<IHBBII"
+ENTRY_FMT = "<%dsIII" % ASSET_PACK_NAME_SIZE
+
+LV_IMG_CF = {
+    "LV_IMG_CF_TRUE_COLOR": 4,
+    "LV_IMG_CF_TRUE_COLOR_ALPHA": 5,
+    "LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED": 6,
+    "LV_IMG_CF_ALPHA_1BIT": 11,
+    "LV_IMG_CF_ALPHA_2BIT": 12,
+    "LV_IMG_CF_ALPHA_4BIT": 13,
+    "LV_IMG_CF_ALPHA_8BIT": 14,
+}
+
+
+def img_header(cf, w, h):
+    # lv_img_header_t: cf:5, always_zero:3, reserved:2, w:11, h:11
+    return (cf & 0x1F) | ((w & 0x7FF) << 10) | ((h & 0x7FF) << 21)
+
+
+def color_section_cond(depth, swap):
+    if depth == 16:
+        return "LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP %s 0" % ("!=" if swap else "==")
+    if depth == 32:
+        return "LV_COLOR_DEPTH == 32"
+    return "LV_COLOR_DEPTH == 1 || LV_COLOR_DEPTH == 8"
+
+
+def load_c(path, depth, swap):
+    text = open(path, encoding="utf-8", errors="ignore").read()
+
+    w = int(re.search(r"\.header\.w\s*=\s*(\d+)", text).group(1))
+    h = int(re.search(r"\.header\.h\s*=\s*(\d+)", text).group(1))
+    cf = LV_IMG_CF[re.search(r"\.header\.cf\s*=\s*(\w+)", text).group(1)]
+
+    cond = "#if " + color_section_cond(depth, swap)
+    start = text.find(cond)
+    if start < 0:
+        raise ValueError("no '%s' section" % cond)
+    end = text.find("#endif", start)
+    body = text[text.find("\n", start):end]
+    body = re.sub(r"/\*.*?\*/", "", body, flags=re.S)
+    data = bytes(int(x, 16) for x in re.findall(r"0x([0-9a-fA-F]{2})", body))
+
+    name = os.path.splitext(os.path.basename(path))[0]
+    if name.startswith("img_src_"):
+        name = name[len("img_src_"):]
+    return name, img_header(cf, w, h), data
+
+
+def load_bin(path):
+    raw = open(path, "rb").read()
+    name = os.path.splitext(os.path.basename(path))[0]
+    return name, struct.unpack_from("<I", raw)[0], raw[4:]
+
+
+def pack(images, depth, swap):
+    images.sort(key=lambda img: img[0].encode())
+
+    names = [img[0] for img in images]
+    if len(set(names)) != len(names):
+        raise ValueError("duplicate image names")
+
+    def align(x):
+        return (x + ASSET_PACK_ALIGN - 1) & ~(ASSET_PACK_ALIGN - 1)
+
+    index_size = len(images) * struct.calcsize(ENTRY_FMT)
+    offset = align(struct.calcsize(HEADER_FMT) + index_size)
+
+    index = b""
+    payload = b""
+    for name, header, data in images:
+        if len(name.encode()) >= ASSET_PACK_NAME_SIZE:
+            raise ValueError("name '%s' is too long" % name)
+        index += struct.pack(ENTRY_FMT, name.encode(), header, offset + len(payload), len(data))
+        payload += data
+        payload += b"\0" * (align(len(payload)) - len(payload))
+
+    size = offset + len(payload)
+    blob = struct.pack(HEADER_FMT, ASSET_PACK_MAGIC, ASSET_PACK_VERSION, depth, swap, len(images), size)
+    blob += index
+    blob += b"\0" * (offset - len(blob))
+    return blob + payload
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("inputs", nargs="+", help="img_src_*.c or *.bin files")
+    parser.add_argument("-o", "--output", default="assets.bin")
+    parser.add_argument("--depth", type=int, default=16, help="LV_COLOR_DEPTH")
+    parser.add_argument("--swap", type=int, default=1, help="LV_COLOR_16_SWAP")
+    parser.add_argument("--partition-size", type=lambda x: int(x, 0), default=0)
+    args = parser.parse_args()
+
+    images = []
+    for path in args.inputs:
+        try:
+            images.append(load_bin(path) if path.endswith(".bin") else load_c(path, args.depth, args.swap))
+        except (AttributeError, KeyError, ValueError) as e:
+            sys.exit("%s: %s" % (path, e))
+
+    blob = pack(images, args.depth, args.swap)
+    if args.partition_size and len(blob) > args.partition_size:
+        sys.exit("pack size %d exceeds the partition size %d" % (len(blob), args.partition_size))
+
+    with open(args.output, "wb") as f:
+        f.write(blob)
+    print("%s: %d images, %d bytes" % (args.output, len(images), len(blob)))
+
+
+if __name__ == "__main__":
+    main()